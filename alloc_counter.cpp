@@ -0,0 +1,53 @@
+// Arquivo: alloc_counter.cpp
+
+#include "alloc_counter.h"
+
+#ifdef KUHN_COUNT_ALLOCS
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<long long> g_allocations(0);
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace alloc_counter {
+    bool enabled() { return true; }
+    long long count() { return g_allocations.load(std::memory_order_relaxed); }
+}
+
+#else
+
+namespace alloc_counter {
+    bool enabled() { return false; }
+    long long count() { return 0; }
+}
+
+#endif
@@ -0,0 +1,11 @@
+#pragma once
+// Arquivo: alloc_counter.h
+
+// Contador de alocações no heap, para depuração.
+// Compile com KUHN_COUNT_ALLOCS definido (as configurações Debug já fazem
+// isso) para substituir o operator new global e contar cada chamada.
+// Sem a flag, count() sempre retorna 0 e nada é substituído.
+namespace alloc_counter {
+    bool enabled();
+    long long count();
+}
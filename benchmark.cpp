@@ -0,0 +1,303 @@
+// Arquivo: benchmark.cpp
+// Benchmarks do solver sem interação, para rodar em máquinas Linux e em CI.
+// Cada resultado é uma linha JSON (JSONL), no stdout ou em --out:
+//
+//   {"benchmark":"train_iterations_per_s","value":...,"unit":"it/s","better":"higher"}
+//   {"curve":"train","iteration":...,"seconds":...,"exploitability_mbb":...}
+//
+// As linhas "benchmark" são comparáveis entre versões: com --baseline ARQ
+// (a saída de uma execução anterior), cada métrica que piorar mais que
+// --tolerance por cento é listada no stderr e o programa sai com código 1.
+// As curvas de exploitability por tempo são só informativas.
+//
+// Opções: --quick (execuções curtas, para CI), --seed S, --out ARQ,
+//         --baseline ARQ, --tolerance PCT (padrão 10)
+
+#include "cfr_poker.h"
+#include "game_solver.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Result {
+    std::string name;
+    double value;
+    const char* unit;
+    bool higherIsBetter;
+};
+
+// Evita que o compilador descarte os loops medidos.
+volatile double sink = 0.0;
+
+double seconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Menor tempo entre "repeats" execuções: o ruído da máquina só soma tempo.
+template <class F>
+double bestOf(int repeats, F f) {
+    double best = 0.0;
+    for (int r = 0; r < repeats; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        const double elapsed = seconds(start);
+        best = r == 0 || elapsed < best ? elapsed : best;
+    }
+    return best;
+}
+
+// Nós visitados por uma iteração do train(): a árvore de apostas inteira de
+// uma distribuição, terminais incluídos.
+int countNodes(History history) {
+    if (HISTORY_INFO[history].row < 0) {
+        return 1;
+    }
+    int nodes = 1;
+    for (int a = 0; a < NUM_ACTIONS; ++a) {
+        nodes += countNodes(nextHistory(history, a));
+    }
+    return nodes;
+}
+
+// Histórico compactado de cada linha de decisão da InfoSetTable.
+std::vector<History> decisionHistories() {
+    std::vector<History> histories(NUM_HISTORIES);
+    for (History h = 0; h < static_cast<History>(MAX_HISTORY); ++h) {
+        if (HISTORY_INFO[h].row >= 0) {
+            histories[HISTORY_INFO[h].row] = h;
+        }
+    }
+    return histories;
+}
+
+// Exploitability por tempo de treino; o relógio para durante as medições.
+template <class Train, class Exploitability>
+void curve(std::ostream& out, const char* name, double budget, int chunk, Train train, Exploitability exploitability) {
+    double elapsed = 0.0;
+    long long done = 0;
+    for (double checkpoint = budget / 64; checkpoint <= budget * 1.0001; checkpoint *= 2) {
+        while (elapsed < checkpoint) {
+            auto start = std::chrono::steady_clock::now();
+            train(chunk);
+            elapsed += seconds(start);
+            done += chunk;
+        }
+        out << "{\"curve\":\"" << name << "\",\"iteration\":" << done << ",\"seconds\":" << elapsed
+            << ",\"exploitability_mbb\":" << exploitability() << "}" << std::endl;
+    }
+}
+
+// Lê as linhas "benchmark" de uma execução anterior.
+std::map<std::string, double> readBaseline(const std::string& path) {
+    std::map<std::string, double> values;
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Nao foi possivel abrir o baseline " << path << std::endl;
+        return values;
+    }
+    const std::string nameKey = "\"benchmark\":\"";
+    const std::string valueKey = "\"value\":";
+    std::string line;
+    while (std::getline(in, line)) {
+        const size_t name = line.find(nameKey);
+        const size_t value = line.find(valueKey);
+        if (name == std::string::npos || value == std::string::npos) {
+            continue;
+        }
+        const size_t begin = name + nameKey.size();
+        values[line.substr(begin, line.find('"', begin) - begin)] = std::atof(line.c_str() + value + valueKey.size());
+    }
+    return values;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool quick = false;
+    unsigned int seed = 1;
+    std::string outPath;
+    std::string baselinePath;
+    double tolerance = 10.0;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            quick = true;
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--out") == 0 && hasValue) {
+            outPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--baseline") == 0 && hasValue) {
+            baselinePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--tolerance") == 0 && hasValue) {
+            tolerance = std::atof(argv[++i]);
+        }
+        else {
+            std::cerr << "Opcao desconhecida: " << argv[i] << std::endl;
+            return 1;
+        }
+    }
+
+    std::ofstream file;
+    if (!outPath.empty()) {
+        file.open(outPath, std::ios::trunc);
+        if (!file) {
+            std::cerr << "Erro ao criar " << outPath << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = outPath.empty() ? std::cout : file;
+    out.precision(6);
+
+    const int scale = quick ? 10 : 1;
+    const int repeats = quick ? 2 : 5;
+    std::vector<Result> results;
+
+    // --- Throughput do treinamento ---
+    const int trainIterations = 2000000 / scale;
+    const double trainSeconds = bestOf(repeats, [&] {
+        CFRTrainer trainer(seed);
+        trainer.setVerbose(false);
+        trainer.train(trainIterations);
+    });
+    const double trainRate = trainIterations / trainSeconds;
+    results.push_back({ "train_iterations_per_s", trainRate, "it/s", true });
+    // O train() visita a árvore inteira de uma distribuição por iteração.
+    results.push_back({ "cfr_ns_per_node", 1e9 / (trainRate * countNodes(ROOT_HISTORY)), "ns", false });
+
+    const int vectorizedIterations = 200000 / scale;
+    const double vectorizedSeconds = bestOf(repeats, [&] {
+        CFRTrainer trainer(seed);
+        trainer.setVerbose(false);
+        trainer.trainVectorized(vectorizedIterations);
+    });
+    results.push_back({ "vectorized_iterations_per_s", vectorizedIterations / vectorizedSeconds, "it/s", true });
+
+    const int leducIterations = 200000 / scale;
+    const double leducSeconds = bestOf(repeats, [&] {
+        std::unique_ptr<GameSolver<LeducGame>> solver(new GameSolver<LeducGame>(seed));
+        solver->train(leducIterations);
+    });
+    results.push_back({ "leduc_iterations_per_s", leducIterations / leducSeconds, "it/s", true });
+
+    // --- Custos por chamada ---
+    // Tabela de um treino curto, para que arrependimentos e somas sejam realistas.
+    CFRTrainer trained(seed);
+    trained.setVerbose(false);
+    trained.train(100000);
+    InfoSetTable table = trained.getTable();
+    const std::vector<History> histories = decisionHistories();
+
+    // Sequência fixa de consultas, lida da memória para não ser constante.
+    const int lookups = 1 << 12;
+    std::vector<int> cards(lookups);
+    std::vector<History> lookupHistories(lookups);
+    std::vector<std::string> names(lookups);
+    std::vector<int> infoSets(lookups);
+    Xoshiro256 rng(seed);
+    for (int i = 0; i < lookups; ++i) {
+        cards[i] = static_cast<int>(rng.nextBelow(NUM_CARDS));
+        const int row = static_cast<int>(rng.nextBelow(NUM_HISTORIES));
+        lookupHistories[i] = histories[row];
+        infoSets[i] = InfoSetTable::index(cards[i], row);
+        names[i] = InfoSetTable::name(infoSets[i]);
+    }
+
+    const int rounds = 2000 / scale;
+    const double calls = static_cast<double>(rounds) * lookups;
+    double strategy[NUM_ACTIONS];
+
+    const double getStrategySeconds = bestOf(repeats, [&] {
+        double sum = 0.0;
+        for (int r = 0; r < rounds; ++r) {
+            for (int i = 0; i < lookups; ++i) {
+                table.node(infoSets[i]).getStrategy(strategy);
+                sum += strategy[0];
+            }
+        }
+        sink = sum;
+    });
+    results.push_back({ "node_get_strategy_ns", getStrategySeconds * 1e9 / calls, "ns", false });
+
+    // Consulta da estratégia final por (carta, histórico compactado).
+    const double lookupSeconds = bestOf(repeats, [&] {
+        double sum = 0.0;
+        for (int r = 0; r < rounds; ++r) {
+            for (int i = 0; i < lookups; ++i) {
+                const int row = InfoSetTable::historyIndex(lookupHistories[i]);
+                table.node(InfoSetTable::index(cards[i], row)).getAverageStrategy(strategy);
+                sum += strategy[0];
+            }
+        }
+        sink = sum;
+    });
+    results.push_back({ "strategy_lookup_ns", lookupSeconds * 1e9 / calls, "ns", false });
+
+    // A mesma consulta pelo nome "carta/histórico" (caminho dos CSVs e do printStrategy).
+    const int nameRounds = rounds / 10 > 0 ? rounds / 10 : 1;
+    const double nameSeconds = bestOf(repeats, [&] {
+        double sum = 0.0;
+        for (int r = 0; r < nameRounds; ++r) {
+            for (int i = 0; i < lookups; ++i) {
+                table.node(InfoSetTable::parse(names[i])).getAverageStrategy(strategy);
+                sum += strategy[0];
+            }
+        }
+        sink = sum;
+    });
+    results.push_back(
+        { "strategy_lookup_by_name_ns", nameSeconds * 1e9 / (static_cast<double>(nameRounds) * lookups), "ns", false });
+
+    for (const Result& result : results) {
+        out << "{\"benchmark\":\"" << result.name << "\",\"value\":" << result.value << ",\"unit\":\"" << result.unit
+            << "\",\"better\":\"" << (result.higherIsBetter ? "higher" : "lower") << "\"}" << std::endl;
+    }
+
+    // --- Exploitability por tempo ---
+    const double budget = quick ? 0.25 : 2.0;
+    {
+        CFRTrainer trainer(seed);
+        trainer.setVerbose(false);
+        curve(out, "train", budget, 1000, [&](int n) { trainer.train(n); }, [&] { return trainer.exploitability(); });
+    }
+    {
+        CFRTrainer trainer(seed);
+        trainer.setVerbose(false);
+        curve(out, "vectorized", budget, 100, [&](int n) { trainer.trainVectorized(n); },
+              [&] { return trainer.exploitability(); });
+    }
+    {
+        std::unique_ptr<GameSolver<LeducGame>> solver(new GameSolver<LeducGame>(seed));
+        curve(out, "leduc", budget, 1000, [&](int n) { solver->train(n); }, [&] { return solver->exploitability(); });
+    }
+
+    if (baselinePath.empty()) {
+        return 0;
+    }
+    const std::map<std::string, double> baseline = readBaseline(baselinePath);
+    int regressions = 0;
+    for (const Result& result : results) {
+        auto it = baseline.find(result.name);
+        if (it == baseline.end() || it->second <= 0) {
+            continue;
+        }
+        const double change = (result.value - it->second) / it->second * 100.0;
+        const bool worse = result.higherIsBetter ? change < -tolerance : change > tolerance;
+        std::cerr << (worse ? "REGRESSAO " : "ok        ") << result.name << ": " << it->second << " -> "
+                  << result.value << " " << result.unit << " (" << (change >= 0 ? "+" : "") << change << "%)"
+                  << std::endl;
+        regressions += worse ? 1 : 0;
+    }
+    return regressions > 0 ? 1 : 0;
+}
@@ -1,201 +1,495 @@
 // Arquivo: cfr_poker.cpp
 
 #include "cfr_poker.h"
+#include "alloc_counter.h"
+#include "strategy_file.h"
+#include "update_rules.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <string> // Adicionado para std::to_string
 
-// Implementao do Construtor
-CFRTrainer::CFRTrainer() {
-    // Inicializa o baralho com 52 cartas
-    for (int i = 0; i < 52; ++i) {
-        deck.push_back(i);
+// Nomes dos históricos de decisão, na ordem de InfoSetTable::historyIndex.
+static const char* HISTORY_NAMES[NUM_HISTORIES] = { "", "p", "b", "pb" };
+
+// Tabela indexada pelo histórico compactado. { row, player, showdown, foldPayoff }
+const HistoryInfo HISTORY_INFO[MAX_HISTORY] = {
+    { -1, 0, 0,  0 }, //  0: inválido
+    {  0, 0, 0,  0 }, //  1: ""
+    {  1, 1, 0,  0 }, //  2: "p"
+    {  2, 1, 0,  0 }, //  3: "b"
+    { -1, 0, 1,  0 }, //  4: "pp"  -> Check, Check -> Showdown (pote baixo)
+    {  3, 0, 0,  0 }, //  5: "pb"
+    { -1, 0, 0,  1 }, //  6: "bp"  -> Bet, Fold
+    { -1, 0, 2,  0 }, //  7: "bb"  -> Bet, Call -> Showdown (pote alto)
+    { -1, 0, 0,  0 }, //  8: "ppp" (inválido)
+    { -1, 0, 0,  0 }, //  9: "ppb" (inválido)
+    { -1, 1, 0, -1 }, // 10: "pbp" -> Pass, Bet, Fold
+    { -1, 1, 2,  0 }, // 11: "pbb" -> Pass, Bet, Call -> Showdown (pote alto)
+    { -1, 0, 0,  0 }, // 12: "bpp" (inválido)
+    { -1, 0, 0,  0 }, // 13: "bpb" (inválido)
+    { -1, 0, 0,  0 }, // 14: "bbp" (inválido)
+    { -1, 0, 0,  0 }, // 15: "bbb" (inválido)
+};
+
+InfoSetTable::InfoSetTable() {
+    std::fill(regretSum, regretSum + NUM_INFOSETS * NUM_ACTIONS, 0.0);
+    std::fill(strategySum, strategySum + NUM_INFOSETS * NUM_ACTIONS, 0.0);
+}
+
+History InfoSetTable::packHistory(const std::string& history) {
+    History packed = ROOT_HISTORY;
+    for (char c : history) {
+        if ((c != 'p' && c != 'b') || packed >= MAX_HISTORY) {
+            return MAX_HISTORY;
+        }
+        packed = nextHistory(packed, c == 'b' ? BET : PASS);
     }
+    return packed < MAX_HISTORY ? packed : MAX_HISTORY;
 }
 
-// Implementao da Funo de Treinamento
-void CFRTrainer::train(int iterations) {
-    double utility = 0.0;
+std::string InfoSetTable::name(int infoSet) {
+    return std::to_string(infoSet % NUM_CARDS) + "/" + HISTORY_NAMES[infoSet / NUM_CARDS];
+}
 
-    // O "baralho" do Kuhn Poker tem apenas 3 cartas. Vamos usar 0, 1, 2 para J, Q, K.
-    std::vector<int> deck = { 0, 1, 2 };
+int InfoSetTable::parse(const std::string& infoSet) {
+    size_t slash = infoSet.find('/');
+    if (slash != 1 || infoSet[0] < '0' || infoSet[0] >= '0' + NUM_CARDS) {
+        return -1;
+    }
+    int history = historyIndex(infoSet.substr(slash + 1));
+    return history < 0 ? -1 : index(infoSet[0] - '0', history);
+}
 
-    std::random_device rd;
-    std::mt19937 g(rd());
+// Implementação do Construtor
+CFRTrainer::CFRTrainer() : CFRTrainer(std::random_device()()) {
+}
 
-    std::cout << "Iniciando treinamento (Kuhn Poker) por " << iterations << " iteracoes..." << std::endl;
+CFRTrainer::CFRTrainer(unsigned int seed)
+    : rng(seed), totalIterations(0), checkpointInterval(0), telemetryInterval(0), datasetEvery(1), verbose(true) {
+    rules.apply(histories);
+}
 
-    for (int i = 0; i < iterations; ++i) {
-        // Embaralha nosso baralho de 3 cartas.
-        std::shuffle(deck.begin(), deck.end(), g);
+void KuhnRules::apply(HistoryInfo* histories) const {
+    for (int h = 0; h < MAX_HISTORY; ++h) {
+        histories[h] = HISTORY_INFO[h];
+        // HISTORY_INFO é o jogo com ante e aposta de 1: pote baixo = 1, pote alto = 2,
+        // e quem desiste perde só a ante.
+        if (histories[h].showdown != 0) {
+            histories[h].showdown = histories[h].showdown == 2 ? ante + betSize : ante;
+        }
+        histories[h].foldPayoff *= ante;
+    }
+}
 
-        // Distribui as cartas para os 2 jogadores.
-        std::vector<int> cards;
-        cards.push_back(deck[0]); // Carta do Jogador 0
-        cards.push_back(deck[1]); // Carta do Jogador 1
+void CFRTrainer::setRules(const KuhnRules& newRules) {
+    rules = newRules;
+    rules.apply(histories);
+}
 
-        // O resto da lgica continua igual!
-        utility += cfr(cards, "", 1.0, 1.0);
+bool UpdateRule::parse(const std::string& name, UpdateRule& rule) {
+    if (name == "cfr") {
+        rule.kind = VANILLA;
+    }
+    else if (name == "cfr+") {
+        rule.kind = CFR_PLUS;
+    }
+    else if (name == "linear") {
+        rule.kind = LINEAR;
+    }
+    else if (name == "dcfr") {
+        rule.kind = DISCOUNTED;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
 
-        if ((i + 1) % 100000 == 0) { // Aumentei o intervalo do log
-            std::cout << "Iteracao: " << (i + 1) << ", Utilidade Media: " << utility / (i + 1) << std::endl;
-        }
+const char* UpdateRule::name() const {
+    switch (kind) {
+    case VANILLA: return "cfr";
+    case LINEAR: return "linear";
+    case DISCOUNTED: return "dcfr";
+    default: return "cfr+";
     }
+}
 
-    std::cout << "Treinamento concluido." << std::endl;
-    std::cout << "Utilidade Media Final: " << utility / iterations << std::endl;
+// Implementação da Função de Treinamento
+int CFRTrainer::train(int iterations, const ConvergenceOptions& options) {
+    switch (updateRule.kind) {
+    case UpdateRule::VANILLA: return trainSampled(VanillaCFR(), iterations, options);
+    case UpdateRule::LINEAR: return trainSampled(LinearCFR(), iterations, options);
+    case UpdateRule::DISCOUNTED:
+        return trainSampled(DiscountedCFR{ updateRule.alpha, updateRule.beta, updateRule.gamma }, iterations, options);
+    default: return trainSampled(CFRPlus(), iterations, options);
+    }
 }
 
-// Implementao da funo CFR principal
-double CFRTrainer::cfr(const std::vector<int>& cards, const std::string& history, double p0, double p1) {
+template <class Rule>
+int CFRTrainer::trainSampled(const Rule& rule, int iterations, const ConvergenceOptions& options) {
+    double utility = 0.0;
 
-    int player_to_act = history.length() % 2;
-    int opponent = 1 - player_to_act;
+    // O "baralho" do Kuhn Poker tem apenas 3 cartas. Vamos usar 0, 1, 2 para J, Q, K.
+    // Arrays fixos: o loop de treinamento não faz nenhuma alocação no heap.
+    int deck[NUM_CARDS];
+    int cards[NUM_PLAYERS];
 
-    // =================================================================
-    // PARTE 1: CASOS BASE (NS TERMINAIS)
-    // =================================================================
-    if (history.length() >= 2) {
-        int payoff_for_p0 = 0; // Usamos 0 como indicador de que no  um n terminal ainda
+    if (verbose) {
+        std::cout << "Iniciando treinamento (Kuhn Poker, " << updateRule.name() << ") por " << iterations
+                  << " iteracoes..." << std::endl;
+    }
 
-        if (history == "pp") {      // Check, Check -> Showdown (pote baixo)
-            payoff_for_p0 = (cards[0] > cards[1]) ? 1 : -1;
-        }
-        else if (history == "bb") {  // Bet, Call -> Showdown (pote alto)
-            payoff_for_p0 = (cards[0] > cards[1]) ? 2 : -2;
+    if (options.checkInterval > 0) {
+        convergence.reserve(convergence.size() + iterations / options.checkInterval + 1);
+    }
+    auto start = std::chrono::steady_clock::now();
+    long long allocationsBefore = alloc_counter::count();
+    KUHN_TELEMETRY_ONLY(const bool streaming = telemetry && telemetry->isOpen();)
+    KUHN_TELEMETRY_ONLY(if (streaming) { telemetry->begin(totalIterations, counters); })
+
+    int i = 0;
+    while (i < iterations) {
+        // Embaralha nosso baralho de 3 cartas, sempre a partir da ordem
+        // original: cada distribuição depende só do estado do RNG, o que
+        // permite retomar um checkpoint exatamente do mesmo ponto.
+        for (int c = 0; c < NUM_CARDS; ++c) {
+            deck[c] = c;
         }
-        else if (history == "pbb") { // Pass, Bet, Call -> Showdown (pote alto)
-            payoff_for_p0 = (cards[0] > cards[1]) ? 2 : -2;
+        std::shuffle(deck, deck + NUM_CARDS, rng);
+
+        // Distribui as cartas para os 2 jogadores.
+        cards[0] = deck[0]; // Carta do Jogador 0
+        cards[1] = deck[1]; // Carta do Jogador 1
+
+        // O resto da lógica continua igual!
+        // Com atualizações alternadas, iterações pares atualizam o jogador 0 e ímpares o 1.
+        const double t = static_cast<double>(totalIterations + 1);
+        int updatePlayer = updateRule.alternating ? static_cast<int>(totalIterations % NUM_PLAYERS) : -1;
+#ifdef KUHN_TELEMETRY
+        // Uma iteração a cada TIMING_PERIOD roda a versão instrumentada do cfr.
+        if (streaming && i % TelemetryCounters::TIMING_PERIOD == 0) {
+            const uint64_t iterationStart = telemetryTicks();
+            utility += cfr<Rule, true>(rule, cards, ROOT_HISTORY, 1.0, 1.0, updatePlayer, t);
+            counters.totalTicks += telemetryTicks() - iterationStart;
+            ++counters.timedIterations;
         }
-        else if (history == "bp") {  // Bet, Fold
-            payoff_for_p0 = 1;
+        else
+#endif
+        utility += cfr(rule, cards, ROOT_HISTORY, 1.0, 1.0, updatePlayer, t);
+        rule.discount(table.regretSum, table.strategySum, NUM_INFOSETS * NUM_ACTIONS, t);
+        ++i;
+        ++totalIterations;
+        maybeCheckpoint(i);
+        KUHN_TELEMETRY_ONLY(if (streaming && i % telemetryInterval == 0) {
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            telemetry->push(totalIterations, elapsed.count(), counters, table.regretSum, table.strategySum);
+        })
+
+        if (verbose && i % 100000 == 0) { // Aumentei o intervalo do log
+            std::cout << "Iteracao: " << i << ", Utilidade Media: " << utility / i << std::endl;
         }
-        else if (history == "pbp") { // Pass, Bet, Fold
-            payoff_for_p0 = -1;
+        if (options.checkInterval > 0 && i % options.checkInterval == 0) {
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (checkConvergence(i, elapsed.count(), options)) {
+                break;
+            }
         }
+    }
 
-        // Se payoff_for_p0 foi alterado, encontramos um n terminal.
-        if (payoff_for_p0 != 0) {
-            return (player_to_act == 0) ? payoff_for_p0 : -payoff_for_p0;
+    long long allocations = alloc_counter::count() - allocationsBefore;
+
+    if (verbose) {
+        std::cout << "Treinamento concluido apos " << i << " iteracoes." << std::endl;
+        std::cout << "Utilidade Media Final: " << utility / i << std::endl;
+        if (alloc_counter::enabled()) {
+            std::cout << "Alocacoes no heap durante o loop: " << allocations << std::endl;
         }
     }
+    return i;
+}
+
+// Implementação da função CFR principal
+// updatePlayer: jogador cujos nós são atualizados nesta passada (-1 = ambos).
+template <class Rule, bool Timed>
+double CFRTrainer::cfr(const Rule& rule, const int* cards, History history, double p0, double p1,
+                       int updatePlayer, double t) {
+
+    const HistoryInfo& info = histories[history];
+    int player_to_act = info.player;
+    KUHN_TELEMETRY_ONLY(if (Timed) { ++counters.nodes; })
 
     // =================================================================
-    // PARTE 2: NS NO-TERMINAIS (PASSO RECURSIVO)
+    // PARTE 1: CASOS BASE (NÓS TERMINAIS)
     // =================================================================
+    if (info.row < 0) {
+        int payoff_for_p0 = info.foldPayoff;
 
-    std::string infoSet = std::to_string(cards[player_to_act]) + "/" + history;
+        if (info.showdown != 0) { // Showdown: o pote vai para a carta mais alta
+            payoff_for_p0 = (cards[0] > cards[1]) ? info.showdown : -info.showdown;
+        }
 
-    auto it = nodeMap.find(infoSet);
-    if (it == nodeMap.end()) {
-        it = nodeMap.emplace(infoSet, Node(2, player_to_act, infoSet)).first;
+        return (player_to_act == 0) ? payoff_for_p0 : -payoff_for_p0;
     }
-    Node* node = &it->second;
 
-    std::vector<double> strategy = node->getStrategy();
-    std::vector<double> actionUtils(node->numActions);
+    // =================================================================
+    // PARTE 2: NÓS NÃO-TERMINAIS (PASSO RECURSIVO)
+    // =================================================================
+
+    KUHN_TELEMETRY_ONLY(const uint64_t lookupStart = Timed ? telemetryTicks() : 0;)
+    Node node = table.node(InfoSetTable::index(cards[player_to_act], info.row));
+
+    double strategy[NUM_ACTIONS];
+    double actionUtils[NUM_ACTIONS];
+    node.getStrategy(strategy);
+    KUHN_TELEMETRY_ONLY(if (Timed) { counters.lookupTicks += telemetryTicks() - lookupStart; })
     double nodeUtility = 0;
 
-    for (int i = 0; i < node->numActions; ++i) {
-        std::string nextHistory = history + (i == 0 ? "p" : "b");
+    for (int i = 0; i < node.numActions; ++i) {
+        History next = nextHistory(history, i);
 
         if (player_to_act == 0) {
-            actionUtils[i] = -cfr(cards, nextHistory, p0 * strategy[i], p1);
+            actionUtils[i] = -cfr<Rule, Timed>(rule, cards, next, p0 * strategy[i], p1, updatePlayer, t);
         }
         else {
-            actionUtils[i] = -cfr(cards, nextHistory, p0, p1 * strategy[i]);
+            actionUtils[i] = -cfr<Rule, Timed>(rule, cards, next, p0, p1 * strategy[i], updatePlayer, t);
         }
 
         nodeUtility += strategy[i] * actionUtils[i];
     }
 
-    for (int i = 0; i < node->numActions; ++i) {
+    if (updatePlayer >= 0 && updatePlayer != player_to_act) {
+        return nodeUtility;
+    }
+
+    KUHN_TELEMETRY_ONLY(const uint64_t updateStart = Timed ? telemetryTicks() : 0;)
+    const double weight = rule.averagingWeight(t);
+    for (int i = 0; i < node.numActions; ++i) {
         double regret = actionUtils[i] - nodeUtility;
         double reachProb = (player_to_act == 0) ? p1 : p0;
-        node->regretSum[i] += reachProb * regret; // (CFR+)
-        if (node->regretSum[i] < 0) {
-            node->regretSum[i] = 0;
-        }
+        node.regretSum[i] = rule.accumulateRegret(node.regretSum[i], reachProb * regret, t);
 
         double myReachProb = (player_to_act == 0) ? p0 : p1;
-        node->strategySum[i] += myReachProb * strategy[i];
+        node.strategySum[i] += weight * myReachProb * strategy[i];
     }
+    KUHN_TELEMETRY_ONLY(if (Timed) { counters.updateTicks += telemetryTicks() - updateStart; })
 
     return nodeUtility;
 }
 
-// Implementao "stub" (vazia) das funes auxiliares
-std::string CFRTrainer::cardsToString(const std::vector<int>& cards) {
-    return ""; // TODO
+bool CFRTrainer::enableTelemetry(const std::string& path, int interval) {
+    if (!telemetry) {
+        telemetry = std::make_shared<TelemetryStream>();
+    }
+    telemetryInterval = interval > 0 ? interval : 100000;
+    return telemetry->open(path, NUM_INFOSETS, NUM_ACTIONS);
+}
+
+bool CFRTrainer::enableDataset(const std::string& prefix, int every, const DatasetOptions& options) {
+    if (!dataset) {
+        dataset = std::make_shared<DatasetWriter>();
+    }
+    datasetEvery = every > 0 ? every : 1;
+    return dataset->open(prefix, NUM_FEATURES, NUM_ACTIONS, options);
 }
 
-std::string CFRTrainer::historyToString(const std::vector<Action>& history) {
-    return ""; // TODO
+void CFRTrainer::enableCheckpoints(const std::string& path, int interval) {
+    checkpointPath = path;
+    checkpointInterval = interval;
+}
+
+void CFRTrainer::maybeCheckpoint(int iteration) {
+    if (checkpointInterval > 0 && iteration % checkpointInterval == 0) {
+        saveCheckpoint(checkpointPath);
+    }
+}
+
+static uint64_t alignOffset(uint64_t offset) {
+    return (offset + CHECKPOINT_ALIGNMENT - 1) / CHECKPOINT_ALIGNMENT * CHECKPOINT_ALIGNMENT;
+}
+
+bool CFRTrainer::saveCheckpoint(const std::string& path) {
+    const uint64_t tableBytes = sizeof(double) * NUM_INFOSETS * NUM_ACTIONS;
+
+    std::ostringstream rngText;
+    rngText << rng;
+    std::string rngState = rngText.str();
+
+    double average[NUM_INFOSETS * NUM_ACTIONS];
+    getAverageStrategy(average);
+
+    CheckpointHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    header.version = CHECKPOINT_VERSION;
+    header.numInfoSets = NUM_INFOSETS;
+    header.numActions = NUM_ACTIONS;
+    header.rngStateSize = static_cast<uint32_t>(rngState.size());
+    header.iterations = static_cast<uint64_t>(totalIterations);
+    header.averageOffset = alignOffset(sizeof(CheckpointHeader));
+    header.regretOffset = alignOffset(header.averageOffset + tableBytes);
+    header.strategySumOffset = alignOffset(header.regretOffset + tableBytes);
+    header.rngOffset = alignOffset(header.strategySumOffset + tableBytes);
+
+    // Escreve em um arquivo temporário e renomeia no fim, para que um leitor
+    // (ou uma queda no meio do treinamento) nunca veja um checkpoint pela metade.
+    std::string tempPath = path + ".tmp";
+    {
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "Nao foi possivel criar " << tempPath << std::endl;
+            return false;
+        }
+        auto writeAt = [&out](uint64_t offset, const void* bytes, uint64_t count) {
+            static const char padding[CHECKPOINT_ALIGNMENT] = {};
+            uint64_t position = static_cast<uint64_t>(out.tellp());
+            out.write(padding, static_cast<std::streamsize>(offset - position));
+            out.write(static_cast<const char*>(bytes), static_cast<std::streamsize>(count));
+        };
+        writeAt(0, &header, sizeof(header));
+        writeAt(header.averageOffset, average, tableBytes);
+        writeAt(header.regretOffset, table.regretSum, tableBytes);
+        writeAt(header.strategySumOffset, table.strategySum, tableBytes);
+        writeAt(header.rngOffset, rngState.data(), rngState.size());
+        if (!out) {
+            std::cerr << "Erro ao gravar " << tempPath << std::endl;
+            return false;
+        }
+    }
+    if (!replaceFile(tempPath, path)) {
+        std::cerr << "Nao foi possivel substituir " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool openCheckpoint(const std::string& path, StrategyFile& file) {
+    if (!file.open(path)) {
+        return false;
+    }
+    if (file.numInfoSets() != NUM_INFOSETS || file.numActions() != NUM_ACTIONS) {
+        std::cerr << "Checkpoint " << path << " nao corresponde ao Kuhn Poker de " << NUM_CARDS << " cartas." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool CFRTrainer::loadCheckpoint(const std::string& path) {
+    StrategyFile file;
+    if (!openCheckpoint(path, file)) {
+        return false;
+    }
+
+    std::memcpy(table.regretSum, file.regretSum(), sizeof(table.regretSum));
+    std::memcpy(table.strategySum, file.strategySum(), sizeof(table.strategySum));
+    totalIterations = static_cast<long long>(file.iterations());
+    std::istringstream rngText(file.rngState());
+    rngText >> rng;
+    return true;
+}
+
+bool CFRTrainer::warmStart(const std::string& checkpointPath, const WarmStartOptions& options) {
+    StrategyFile file;
+    if (!openCheckpoint(checkpointPath, file)) {
+        return false;
+    }
+
+    const double* regrets = file.regretSum();
+    const double* sums = file.strategySum();
+    for (int i = 0; i < NUM_INFOSETS * NUM_ACTIONS; ++i) {
+        table.regretSum[i] = options.regretDiscount * regrets[i];
+        table.strategySum[i] = options.strategyDiscount * sums[i];
+    }
+    totalIterations = std::llround(static_cast<double>(file.iterations()) * options.strategyDiscount);
+    return true;
+}
+
+void CFRTrainer::getCurrentStrategy(double* out) {
+    for (int infoSet = 0; infoSet < NUM_INFOSETS; ++infoSet) {
+        table.node(infoSet).getStrategy(&out[infoSet * NUM_ACTIONS]);
+    }
+}
+
+void CFRTrainer::getAverageStrategy(double* out) {
+    for (int infoSet = 0; infoSet < NUM_INFOSETS; ++infoSet) {
+        table.node(infoSet).getAverageStrategy(&out[infoSet * NUM_ACTIONS]);
+    }
+}
+
+bool CFRTrainer::exportCSV(const std::string& path) {
+    double average[NUM_INFOSETS * NUM_ACTIONS];
+    getAverageStrategy(average);
+    return exportStrategyCSV(average, path);
 }
 
 void CFRTrainer::printStrategy(const std::string& infoSet) {
-    auto it = nodeMap.find(infoSet);
-    if (it == nodeMap.end()) {
-        // Se a estratgia no for encontrada, podemos imprimir uma mensagem ou ficar em silncio.
+    int index = InfoSetTable::parse(infoSet);
+    if (index < 0) {
+        // Se a estratégia não for encontrada, podemos imprimir uma mensagem ou ficar em silêncio.
         // Vamos manter a mensagem de erro por enquanto.
         std::cout << "  -> Estrategia para o no " << infoSet << " nao encontrada." << std::endl;
         return;
     }
 
-    Node* node = &it->second;
-    std::vector<double> avgStrategy = node->getAverageStrategy();
+    Node node = table.node(index);
+    double avgStrategy[NUM_ACTIONS];
+    node.getAverageStrategy(avgStrategy);
 
-    // Agora a funo apenas imprime os dados, no o ttulo.
+    // Agora a função apenas imprime os dados, não o título.
     std::cout << "  - PASS (Check/Fold): " << avgStrategy[0] * 100 << "%" << std::endl;
     std::cout << "  - BET (Bet/Call):    " << avgStrategy[1] * 100 << "%" << std::endl;
 }
 /*
-Explicao do Cdigo
+Explicação do Código
 Construtor CFRTrainer::CFRTrainer()
-Este cdigo  executado uma vez quando criamos um objeto CFRTrainer.
+Este código é executado uma vez quando criamos um objeto CFRTrainer.
 
-Ele simplesmente preenche nosso vetor deck com 52 inteiros, de 0 a 51. Cada nmero representa uma carta nica. Essa  uma forma computacionalmente eficiente de lidar com cartas.
+Ele apenas inicializa o gerador aleatório. O baralho de 3 cartas é montado localmente em train(), a cada mão; o antigo vetor de 52 cartas nunca era usado e foi removido.
 
-Funo CFRTrainer::train(int iterations)
-Esta  a funo que chamaremos para iniciar todo o processo.
+Função CFRTrainer::train(int iterations)
+Esta é a função que chamaremos para iniciar todo o processo.
 
-utility: Usamos esta varivel para somar os resultados de cada mo. Ao dividir pelo nmero de iteraes, podemos ver o EV (Valor Esperado) mdio do jogo. Em um jogo simtrico, esse valor deve tender a zero, indicando que nosso algoritmo est convergindo corretamente.
+utility: Usamos esta variável para somar os resultados de cada mão. Ao dividir pelo número de iterações, podemos ver o EV (Valor Esperado) médio do jogo. Em um jogo simétrico, esse valor deve tender a zero, indicando que nosso algoritmo está convergindo corretamente.
 
-Embaralhamento: Em vez do antigo std::random_shuffle, usamos o std::shuffle com um gerador mt19937 do C++11, que fornece uma aleatoriedade de muito maior qualidade, essencial para simulaes como esta.
+Embaralhamento: Em vez do antigo std::random_shuffle, usamos o std::shuffle com um gerador mt19937 do C++11, que fornece uma aleatoriedade de muito maior qualidade, essencial para simulações como esta.
 
-Distribuio de Cartas: Por enquanto, para manter a simplicidade absoluta, estamos simulando um jogo super simples onde cada jogador recebe apenas uma carta. Isso nos permite focar 100% na lgica do CFR. Assim que validarmos que o CFR funciona, expandiremos para 2 cartas por jogador e adicionaremos o board.
+Distribuição de Cartas: Por enquanto, para manter a simplicidade absoluta, estamos simulando um jogo super simples onde cada jogador recebe apenas uma carta. Isso nos permite focar 100% na lógica do CFR. Assim que validarmos que o CFR funciona, expandiremos para 2 cartas por jogador e adicionaremos o board.
 
-Chamada do cfr(...): Este  o ponto de partida para a recurso em cada mo.
+Chamada do cfr(...): Este é o ponto de partida para a recursão em cada mão.
 
 cards: Passamos as cartas que acabamos de distribuir.
 
-"": O histrico de aes comea vazio na raiz da rvore.
+"": O histórico de ações começa vazio na raiz da árvore.
 
-1.0, 1.0: No incio da mo, a probabilidade de cada jogador ter chegado a este ponto  100% (ou 1.0). Essas so as "reach probabilities" iniciais.
+1.0, 1.0: No início da mão, a probabilidade de cada jogador ter chegado a este ponto é 100% (ou 1.0). Essas são as "reach probabilities" iniciais.
 
-Progresso: O if ((i + 1) % 1000 == 0)  apenas uma forma de nos dar feedback visual durante um treinamento longo, imprimindo o status a cada 1000 mos simuladas.
+Progresso: O if ((i + 1) % 1000 == 0) é apenas uma forma de nos dar feedback visual durante um treinamento longo, imprimindo o status a cada 1000 mãos simuladas.
 */
 
 
 /*
-EXCELENTE! Fico muito feliz em ouvir isso. Ter um projeto dessa complexidade compilando sem erros  o marco mais importante. Isso significa que nossa fundao est slida.
+EXCELENTE! Fico muito feliz em ouvir isso. Ter um projeto dessa complexidade compilando sem erros é o marco mais importante. Isso significa que nossa fundação está sólida.
 
-Agora, a parte mais empolgante. Vamos adicionar a pea final do quebra-cabea: o loop recursivo e o mecanismo de aprendizado da funo cfr.
+Agora, a parte mais empolgante. Vamos adicionar a peça final do quebra-cabeça: o loop recursivo e o mecanismo de aprendizado da função cfr.
 
-Fase 1, Etapa 6: O Corao do CFR - Recurso e Arrependimento
-At agora, nossa funo cfr sabe:
+Fase 1, Etapa 6: O Coração do CFR - Recursão e Arrependimento
+Até agora, nossa função cfr sabe:
 
-Identificar o fim da mo e calcular o resultado (ns terminais).
+Identificar o fim da mão e calcular o resultado (nós terminais).
 
-Para uma deciso no meio da mo, ela sabe encontrar ou criar o n e obter a estratgia atual.
+Para uma decisão no meio da mão, ela sabe encontrar ou criar o nó e obter a estratégia atual.
 
-O que faremos agora  substituir o return 0.0; provisrio pela lgica que explora cada ao possvel, descobre seus resultados e aprende com eles, atualizando os arrependimentos.
+O que faremos agora é substituir o return 0.0; provisório pela lógica que explora cada ação possível, descobre seus resultados e aprende com eles, atualizando os arrependimentos.
 
-Sua Tarefa: Substitua sua funo CFRTrainer::cfr inteira pela verso completa abaixo.
+Sua Tarefa: Substitua sua função CFRTrainer::cfr inteira pela versão completa abaixo.
 
 C++
 
 // Arquivo: cfr_poker.cpp
-// Substitua sua funo cfr() inteira por esta verso completa.
+// Substitua sua função cfr() inteira por esta versão completa.
 
 double CFRTrainer::cfr(const std::vector<int>& cards, const std::string& history, double p0, double p1) {
 
@@ -203,7 +497,7 @@ double CFRTrainer::cfr(const std::vector<int>& cards, const std::string& history
     int opponent = 1 - player_to_act;
 
     // =================================================================
-    // PARTE 1: CASOS BASE (NS TERMINAIS) - J IMPLEMENTADO
+    // PARTE 1: CASOS BASE (NÓS TERMINAIS) - JÁ IMPLEMENTADO
     // =================================================================
     if (history.length() >= 2) {
         char last_action = history.back();
@@ -217,7 +511,7 @@ double CFRTrainer::cfr(const std::vector<int>& cards, const std::string& history
 
         if (showdown) {
             int payoff = (cards[0] > cards[1]) ? 1 : -1;
-            // Se houve uma aposta, o valor em jogo  maior
+            // Se houve uma aposta, o valor em jogo é maior
             if (history.find('b') != std::string::npos) {
                 payoff *= 2;
             }
@@ -230,10 +524,10 @@ double CFRTrainer::cfr(const std::vector<int>& cards, const std::string& history
     }
 
     // =================================================================
-    // PARTE 2: NS NO-TERMINAIS (PASSO RECURSIVO) - LGICA COMPLETA
+    // PARTE 2: NÓS NÃO-TERMINAIS (PASSO RECURSIVO) - LÓGICA COMPLETA
     // =================================================================
 
-    // 1. Identificar o n e obter a estratgia (j implementado)
+    // 1. Identificar o nó e obter a estratégia (já implementado)
     std::string infoSet = std::to_string(cards[player_to_act]) + "/" + history;
     auto it = nodeMap.find(infoSet);
     if (it == nodeMap.end()) {
@@ -242,14 +536,14 @@ double CFRTrainer::cfr(const std::vector<int>& cards, const std::string& history
     Node* node = &it->second;
     std::vector<double> strategy = node->getStrategy();
 
-    // 2. Iterar sobre as aes, explorar recursivamente e calcular utilidades
+    // 2. Iterar sobre as ações, explorar recursivamente e calcular utilidades
     std::vector<double> actionUtils(node->numActions);
     double nodeUtility = 0;
 
     for (int i = 0; i < node->numActions; ++i) {
         std::string nextHistory = history + (i == 0 ? "p" : "b"); // 'p' para PASS, 'b' para BET
 
-        // A utilidade retornada pela chamada recursiva  do ponto de vista do PRXIMO jogador.
+        // A utilidade retornada pela chamada recursiva é do ponto de vista do PRÓXIMO jogador.
         // Portanto, invertemos o sinal para obter a utilidade do ponto de vista do JOGADOR ATUAL.
         if (player_to_act == 0) {
             actionUtils[i] = -cfr(cards, nextHistory, p0 * strategy[i], p1);
@@ -257,16 +551,16 @@ double CFRTrainer::cfr(const std::vector<int>& cards, const std::string& history
             actionUtils[i] = -cfr(cards, nextHistory, p0, p1 * strategy[i]);
         }
 
-        // Acumula a utilidade total do n, ponderada pela estratgia.
+        // Acumula a utilidade total do nó, ponderada pela estratégia.
         nodeUtility += strategy[i] * actionUtils[i];
     }
 
-    // 3. Calcular e acumular arrependimentos e estratgia mdia
+    // 3. Calcular e acumular arrependimentos e estratégia média
     for (int i = 0; i < node->numActions; ++i) {
-        // Arrependimento = (Utilidade da ao) - (Utilidade mdia do n)
+        // Arrependimento = (Utilidade da ação) - (Utilidade média do nó)
         double regret = actionUtils[i] - nodeUtility;
 
-        // Pondera o arrependimento e a estratgia pelas probabilidades de alcance (reach probabilities)
+        // Pondera o arrependimento e a estratégia pelas probabilidades de alcance (reach probabilities)
         double reachProb = (player_to_act == 0) ? p1 : p0; // Probabilidade do oponente chegar aqui
         node->regretSum[i] += reachProb * regret;
 
@@ -276,26 +570,26 @@ double CFRTrainer::cfr(const std::vector<int>& cards, const std::string& history
 
     return nodeUtility;
 }
-Explicao da Lgica Adicionada
-Esta  a parte mais densa, vamos quebrar:
+Explicação da Lógica Adicionada
+Esta é a parte mais densa, vamos quebrar:
 
-actionUtils e nodeUtility: actionUtils  um vetor para guardar o valor (EV) de cada ao possvel (PASS e BET). nodeUtility ser o valor mdio esperado deste n, considerando nossa estratgia atual.
+actionUtils e nodeUtility: actionUtils é um vetor para guardar o valor (EV) de cada ação possível (PASS e BET). nodeUtility será o valor médio esperado deste nó, considerando nossa estratégia atual.
 
-O Loop for: Ns iteramos sobre cada ao i (0 para PASS, 1 para BET).
+O Loop for: Nós iteramos sobre cada ação i (0 para PASS, 1 para BET).
 
 A Chamada Recursiva -cfr(...):
 
-- (Sinal Negativo): Este  um detalhe crucial. A funo cfr retorna a utilidade do ponto de vista do jogador da vez. Quando chamamos cfr para o prximo estado, o jogador da vez ser nosso oponente. Portanto, a utilidade retornada ser a dele. Para obter a nossa utilidade, simplesmente invertemos o sinal.
+- (Sinal Negativo): Este é um detalhe crucial. A função cfr retorna a utilidade do ponto de vista do jogador da vez. Quando chamamos cfr para o próximo estado, o jogador da vez será nosso oponente. Portanto, a utilidade retornada será a dele. Para obter a nossa utilidade, simplesmente invertemos o sinal.
 
-p0 * strategy[i]: Aqui atualizamos a "probabilidade de alcance". Se a chance de o Jogador 0 chegar a este n era p0, e a chance dele escolher a ao i  strategy[i], ento a chance de ele chegar ao prximo n (aps a ao i)  p0 * strategy[i].
+p0 * strategy[i]: Aqui atualizamos a "probabilidade de alcance". Se a chance de o Jogador 0 chegar a este nó era p0, e a chance dele escolher a ação i é strategy[i], então a chance de ele chegar ao próximo nó (após a ação i) é p0 * strategy[i].
 
-Clculo da Utilidade do N: Aps o loop, nodeUtility  calculado como uma mdia ponderada.  o EV total deste n se seguirmos a estratgia atual. (Probabilidade de PASS * EV de PASS) + (Probabilidade de BET * EV de BET).
+Cálculo da Utilidade do Nó: Após o loop, nodeUtility é calculado como uma média ponderada. É o EV total deste nó se seguirmos a estratégia atual. (Probabilidade de PASS * EV de PASS) + (Probabilidade de BET * EV de BET).
 
-Clculo e Acumulao do Arrependimento:
+Cálculo e Acumulação do Arrependimento:
 
-regret = actionUtils[i] - nodeUtility: Esta  a frmula mgica. O arrependimento de uma ao  o quo melhor (ou pior) ela foi em comparao com o valor mdio de ter chegado a este n.
+regret = actionUtils[i] - nodeUtility: Esta é a fórmula mágica. O arrependimento de uma ação é o quão melhor (ou pior) ela foi em comparação com o valor médio de ter chegado a este nó.
 
-node->regretSum[i] += reachProb * regret: Ns somamos o arrependimento ao nosso total acumulado, mas o ponderamos pela probabilidade do oponente ter chegado a este n. Isso garante que damos mais peso aos arrependimentos em partes da rvore que so alcanadas com mais frequncia.
+node->regretSum[i] += reachProb * regret: Nós somamos o arrependimento ao nosso total acumulado, mas o ponderamos pela probabilidade do oponente ter chegado a este nó. Isso garante que damos mais peso aos arrependimentos em partes da árvore que são alcançadas com mais frequência.
 
-Acumulao da Estratgia Mdia: De forma similar, acumulamos a probabilidade da estratgia (strategy[i]) ponderada pela nossa prpria probabilidade de alcance. Isso  o que nos dar a estratgia GTO final no getAverageStrategy().
+Acumulação da Estratégia Média: De forma similar, acumulamos a probabilidade da estratégia (strategy[i]) ponderada pela nossa própria probabilidade de alcance. Isso é o que nos dará a estratégia GTO final no getAverageStrategy().
 */
\ No newline at end of file
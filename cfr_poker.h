@@ -3,44 +3,88 @@
 
 #include <vector>
 #include <string>
-#include <map>
-#include <algorithm> // Necessrio para std::shuffle
-#include <random>    // Necessrio para std::mt19937
+#include <algorithm> // Necessário para std::shuffle
+#include <random>    // Necessário para std::mt19937
+#include <memory>
+#include "dataset.h"
+#include "telemetry.h"
 
-// Definindo o nmero de jogadores.
+// Definindo o número de jogadores.
 const int NUM_PLAYERS = 2;
 
-// Enum para as aes possveis.
+// Dimensões do Kuhn Poker: 3 cartas (J, Q, K), 2 ações (PASS, BET) e
+// 4 históricos onde alguém ainda precisa decidir: "", "p", "b" e "pb".
+// NUM_ACTIONS é o máximo de ações em qualquer nó e dimensiona os arrays de pilha.
+const int NUM_CARDS = 3;
+const int NUM_ACTIONS = 2;
+const int NUM_HISTORIES = 4;
+const int NUM_INFOSETS = NUM_CARDS * NUM_HISTORIES;
+// Entrada da rede neural (train_nn.py): one-hot da carta seguido do one-hot do histórico.
+const int NUM_FEATURES = NUM_CARDS + NUM_HISTORIES;
+
+// Vetores "por carta" do modo vetorizado são completados com zeros até um
+// múltiplo de 4 doubles (um registrador AVX), para que os loops tenham
+// tamanho fixo e o compilador os vetorize sem código de sobra.
+const int CARD_LANES = (NUM_CARDS + 3) / 4 * 4;
+
+// Enum para as ações possíveis.
 enum Action {
     PASS,
     BET
 };
 
-// A estrutura principal que representa um n na rvore do jogo.
-struct Node {
-    // --- Identificador do N (Chave nica) ---
-    std::string infoSet;
+// Histórico compactado em um inteiro: um bit por ação (0 = PASS, 1 = BET)
+// abaixo de um bit sentinela que marca o comprimento.
+// Ex: "" = 0b1, "p" = 0b10, "pb" = 0b101, "pbb" = 0b1011.
+typedef unsigned int History;
+const History ROOT_HISTORY = 1;
+const int MAX_HISTORY = 16; // O maior histórico do Kuhn ("pbb") vale 11.
+
+inline History nextHistory(History history, int action) {
+    return (history << 1) | action;
+}
+
+// O que sabemos de cada histórico, pré-calculado: substitui a cadeia de
+// comparações de strings ("pbb", "bp"...) por uma consulta em tabela.
+struct HistoryInfo {
+    int row;        // Histórico de decisão na InfoSetTable, ou -1 se terminal/inválido
+    int player;     // Jogador da vez (nos terminais, quem "agiria" a seguir)
+    int showdown;   // Valor ganho no showdown (0 se não houver showdown)
+    int foldPayoff; // Payoff do jogador 0 quando alguém desiste (0 se não houver fold)
+};
+extern const HistoryInfo HISTORY_INFO[MAX_HISTORY];
+
+// Payoffs do Kuhn em fichas. A árvore de apostas é sempre a mesma; a ante e
+// o tamanho da aposta só mudam os valores dos terminais. Os padrões são os do
+// jogo original, o mesmo de HISTORY_INFO.
+struct KuhnRules {
+    int ante = 1;
+    int betSize = 1;
+
+    // Copia HISTORY_INFO para "histories" com os payoffs destas regras.
+    void apply(HistoryInfo* histories) const;
+};
 
+// A estrutura principal que representa um nó na árvore do jogo.
+// Não guarda mais os dados: é uma "janela" para uma linha da InfoSetTable.
+struct Node {
     // --- Estado do Jogo ---
     int playerToAct;
 
-    // --- Estratgia e Arrependimento (O Corao do CFR) ---
+    // --- Estratégia e Arrependimento (O Coração do CFR) ---
     int numActions;
-    std::vector<double> regretSum;
-    std::vector<double> strategySum;
-
-    // Construtor Corrigido: Usado para inicializar um novo n.
-    Node(int actions, int player, const std::string& set)
-        : numActions(actions), playerToAct(player), infoSet(set) {
-        regretSum.assign(numActions, 0.0);
-        strategySum.assign(numActions, 0.0);
+    double* regretSum;
+    double* strategySum;
+
+    Node(int actions, int player, double* regrets, double* strategies)
+        : playerToAct(player), numActions(actions), regretSum(regrets), strategySum(strategies) {
     }
 
-    // --- Mtodos (Funes do N) ---
+    // --- Métodos (Funções do Nó) ---
 
-    // Calcula a estratgia atual com base nos arrependimentos.
-    std::vector<double> getStrategy() {
-        std::vector<double> strategy(numActions);
+    // Calcula a estratégia atual com base nos arrependimentos.
+    // "strategy" precisa de numActions posições (normalmente um array na pilha).
+    void getStrategy(double* strategy) const {
         double totalRegret = 0;
 
         for (int i = 0; i < numActions; ++i) {
@@ -58,13 +102,10 @@ struct Node {
                 strategy[i] = 1.0 / numActions;
             }
         }
-
-        return strategy;
     }
 
-    // Calcula a estratgia mdia, que  a nossa estratgia GTO final.
-    std::vector<double> getAverageStrategy() {
-        std::vector<double> avgStrategy(numActions);
+    // Calcula a estratégia média, que é a nossa estratégia GTO final.
+    void getAverageStrategy(double* avgStrategy) const {
         double totalSum = 0;
 
         for (int i = 0; i < numActions; ++i) {
@@ -81,63 +122,270 @@ struct Node {
                 avgStrategy[i] = 1.0 / numActions;
             }
         }
+    }
+};
 
-        return avgStrategy;
+// Tabela densa de infosets. Cada par (carta privada, histórico) recebe um
+// índice fixo, calculado sem montar strings, e os arrependimentos e somas de
+// estratégia ficam em dois arrays contíguos (structure-of-arrays). A tabela
+// inteira ocupa 384 bytes e cabe folgada no cache L1.
+struct InfoSetTable {
+    double regretSum[NUM_INFOSETS * NUM_ACTIONS];
+    double strategySum[NUM_INFOSETS * NUM_ACTIONS];
+
+    InfoSetTable();
+
+    // Índice do infoset: históricos contíguos, uma linha por carta.
+    static int index(int card, int history) { return history * NUM_CARDS + card; }
+
+    // Índice do histórico ("", "p", "b", "pb") ou -1 se não for de decisão.
+    static int historyIndex(History history) { return history < MAX_HISTORY ? HISTORY_INFO[history].row : -1; }
+    static int historyIndex(const std::string& history) { return historyIndex(packHistory(history)); }
+
+    // Converte "pb" etc. para o formato compactado (MAX_HISTORY se for longo demais).
+    static History packHistory(const std::string& history);
+
+    // Jogador da vez em um histórico de decisão.
+    static int playerToAct(int history) { return (history == 1 || history == 2) ? 1 : 0; }
+
+    Node node(int infoSet) {
+        return Node(NUM_ACTIONS, playerToAct(infoSet / NUM_CARDS),
+                    &regretSum[infoSet * NUM_ACTIONS], &strategySum[infoSet * NUM_ACTIONS]);
+    }
+
+    // Vetor de NUM_FEATURES posições igual ao state_to_features() do train_nn.py.
+    static void features(int card, int history, double* out) {
+        for (int f = 0; f < NUM_FEATURES; ++f) {
+            out[f] = 0.0;
+        }
+        out[card] = 1.0;
+        out[NUM_CARDS + history] = 1.0;
     }
+
+    // Visão textual ("carta/histórico"), usada apenas para depuração e exportação.
+    static std::string name(int infoSet);
+    static int parse(const std::string& infoSet); // -1 se o infoset não existir
+};
+
+// Acompanhamento da convergência durante o treinamento. A exploitability é
+// medida em milli-big-blinds por mão (mbb/mão), tomando a ante de 1 ficha
+// como o big blind do Kuhn Poker.
+struct ConvergenceOptions {
+    int checkInterval = 0;  // Mede a exploitability a cada N iterações (0 = nunca)
+    double targetMbb = 0.0; // Para o treinamento ao atingir esse valor (0 = nunca para)
+};
+
+struct ConvergencePoint {
+    int iteration;
+    double seconds;
+    double exploitabilityMbb;
+};
+
+// Treinamento amostrado em várias threads. Cada thread sorteia suas próprias
+// distribuições. O treino anda em rodadas de syncInterval iterações ao todo,
+// divididas entre as threads.
+//
+// Modo atômico (padrão): as threads somam direto na tabela global, como o
+// train() faria, mas o resultado deixa de ser reprodutível.
+//
+// Modo shards: cada thread acumula em um "shard" local, somado à tabela
+// global no fim da rodada sempre na mesma ordem, então a mesma semente dá o
+// mesmo resultado. O preço: a estratégia fica congelada durante a rodada e a
+// rodada inteira conta como um passo de arrependimento, então com o mesmo
+// número de iterações a exploitability fica acima da do train() (no Kuhn, 400
+// mil iterações: ~1.2 mbb no train(), ~2.8 com rodadas de 256, ~8 com 1000).
+// Rodadas menores aproximam do train() e sincronizam mais.
+struct ParallelOptions {
+    int numThreads = 1;
+    unsigned int seed = 0;
+    int syncInterval = 256;
+    bool atomicUpdates = true;
+};
+
+// Escolha da regra de atualização (ver update_rules.h). A escolha é feita
+// uma vez por chamada de train(); o loop roda a versão especializada da regra.
+struct UpdateRule {
+    enum Kind { VANILLA, CFR_PLUS, LINEAR, DISCOUNTED };
+
+    Kind kind = CFR_PLUS;
+    // Atualizações alternadas: em cada iteração (ou passada) só um jogador
+    // atualiza, já enxergando a estratégia nova do outro.
+    bool alternating = true;
+    // Parâmetros do DCFR; os padrões são os recomendados no artigo original.
+    double alpha = 1.5;
+    double beta = 0.0;
+    double gamma = 2.0;
+
+    // "cfr", "cfr+", "linear" ou "dcfr". Retorna false para nomes desconhecidos.
+    static bool parse(const std::string& name, UpdateRule& rule);
+    const char* name() const;
+};
+
+// Warm start: o treinamento parte de uma solução anterior (por exemplo, de
+// uma variante com outra ante ou aposta) em vez de arrependimentos zerados.
+struct WarmStartOptions {
+    // Checkpoint: fatores aplicados às somas antigas (1 = mantém tudo, 0 = descarta).
+    // O contador de iterações é multiplicado por strategyDiscount, para que os
+    // pesos do CFR+ e do Linear CFR continuem proporcionais à massa que sobrou.
+    double regretDiscount = 1.0;
+    double strategyDiscount = 1.0;
+    // Estratégia sem arrependimentos (.csv, .kmlp, "gto"): quantas iterações
+    // ela vale. Os arrependimentos são reconstruídos como se ela tivesse sido
+    // jogada em todas essas iterações contra si mesma.
+    int strategyIterations = 100;
+};
+
+// Resolução de um subjogo (CFRTrainer::solveSubgame, SubgameResolver): CFR+
+// vetorizado a partir de um histórico público, com os alcances dos dois
+// jogadores fixos na raiz. Para no primeiro orçamento que acabar.
+struct SubgameQuery {
+    History root = ROOT_HISTORY;                 // Histórico de decisão (ex: packHistory("pb"))
+    double ranges[NUM_PLAYERS][NUM_CARDS] = {};  // Alcance de cada jogador por carta
+    int maxIterations = 1000;                    // 0 = sem limite de iterações
+    double maxSeconds = 0.0;                     // 0 = sem limite de tempo
+};
+
+struct SubgameSolution {
+    double strategy[NUM_CARDS][NUM_ACTIONS];     // Estratégia média na raiz, por carta de quem age
+    int iterations;
+    double seconds;
 };
 
 // A classe principal que orquestra o treinamento.
 class CFRTrainer {
 public:
     CFRTrainer();
-    void train(int iterations);
+    explicit CFRTrainer(unsigned int seed);
+    // Os dois modos retornam quantas iterações foram de fato executadas.
+    int train(int iterations, const ConvergenceOptions& options = ConvergenceOptions());
+    void setUpdateRule(const UpdateRule& rule) { updateRule = rule; }
+    // Desliga as mensagens de progresso no std::cout (usado pelo módulo Python).
+    void setVerbose(bool enabled) { verbose = enabled; }
+    const UpdateRule& getUpdateRule() const { return updateRule; }
+    // Ante e aposta do jogo resolvido. Pode ser trocado entre chamadas de
+    // train(): as tabelas são mantidas, o que já é um warm start da variante nova.
+    void setRules(const KuhnRules& newRules);
+    const KuhnRules& getRules() const { return rules; }
+    // CFR+ determinístico: percorre a árvore de apostas uma vez por jogador a
+    // cada iteração, cobrindo todas as distribuições de cartas de uma só vez.
+    int trainVectorized(int iterations, const ConvergenceOptions& options = ConvergenceOptions());
+    int trainParallel(int iterations, const ParallelOptions& parallel,
+                      const ConvergenceOptions& options = ConvergenceOptions());
     void printStrategy(const std::string& infoSet);
 
-private:
-    std::map<std::string, Node> nodeMap;
-    std::vector<int> deck;
-
-    double cfr(const std::vector<int>& cards, const std::string& history, double p0, double p1);
+    // Exploitability da estratégia média atual: média do ganho de uma melhor
+    // resposta contra cada jogador, em mbb/mão.
+    double exploitability();
+    const std::vector<ConvergencePoint>& getConvergence() const { return convergence; }
+
+    // Estratégia média de todos os infosets: NUM_INFOSETS * NUM_ACTIONS posições.
+    void getAverageStrategy(double* out);
+    // Acesso direto às tabelas (o módulo Python as expõe sem cópia).
+    const InfoSetTable& getTable() const { return table; }
+
+    // --- Persistência (formato descrito em strategy_file.h) ---
+    // O checkpoint guarda as tabelas, o total de iterações e o estado do RNG:
+    // retomar dele continua o treinamento exatamente do mesmo ponto.
+    bool saveCheckpoint(const std::string& path);
+    bool loadCheckpoint(const std::string& path);
+    // Warm start a partir das tabelas de um checkpoint, descontadas conforme
+    // "options". Ao contrário do loadCheckpoint, o RNG não é restaurado.
+    bool warmStart(const std::string& checkpointPath, const WarmStartOptions& options);
+    // Warm start a partir de uma estratégia (NUM_INFOSETS * NUM_ACTIONS
+    // posições): arrependimentos = valor contrafactual de cada ação menos o da
+    // estratégia, contra ela mesma, nas regras atuais. Substitui as tabelas.
+    void warmStart(const double* strategy, const WarmStartOptions& options);
+
+    // Resolve o subjogo de "query" usando as tabelas deste treinador como área
+    // de trabalho (o conteúdo anterior é descartado). Não aloca nada.
+    // Retorna false se a raiz não for um histórico de decisão ou não houver orçamento.
+    bool solveSubgame(const SubgameQuery& query, SubgameSolution& solution);
+    // Salva um checkpoint a cada "interval" iterações de train()/trainVectorized()
+    // (no trainParallel(), na primeira rodada que passar de cada múltiplo).
+    void enableCheckpoints(const std::string& path, int interval);
+    bool exportCSV(const std::string& path);
+    long long getIterations() const { return totalIterations; }
+    // Grava uma amostra de telemetria (telemetry.h) a cada "interval" iterações de train().
+    bool enableTelemetry(const std::string& path, int interval);
+    // Dataset para redes (dataset.h): as threads do trainParallel() gravam um
+    // registro a cada "every" atualizações de infoset. Features como em
+    // InfoSetTable::features(); vantagens = incremento de arrependimento.
+    bool enableDataset(const std::string& prefix, int every, const DatasetOptions& options = DatasetOptions());
+    DatasetWriter* getDataset() { return dataset.get(); }
 
-    // Funes auxiliares
-    std::string cardsToString(const std::vector<int>& cards);
-    std::string historyToString(const std::vector<Action>& history);
+private:
+    InfoSetTable table;
+    std::vector<ConvergencePoint> convergence;
+    std::mt19937 rng;
+    UpdateRule updateRule;
+    KuhnRules rules;
+    HistoryInfo histories[MAX_HISTORY]; // HISTORY_INFO com os payoffs de "rules"
+    long long totalIterations;
+    std::string checkpointPath;
+    int checkpointInterval;
+    TelemetryCounters counters;
+    std::shared_ptr<TelemetryStream> telemetry;
+    int telemetryInterval;
+    std::shared_ptr<DatasetWriter> dataset;
+    int datasetEvery;
+    bool verbose;
+
+    void maybeCheckpoint(int iteration);
+
+    // Registra um ponto de convergência; retorna true se a meta foi atingida.
+    bool checkConvergence(int iteration, double seconds, const ConvergenceOptions& options);
+    void bestResponse(History history, int responder, const double* oppReach, double* values);
+
+    // Versões especializadas por regra (definidas nos .cpp que as usam).
+    template <class Rule>
+    int trainSampled(const Rule& rule, int iterations, const ConvergenceOptions& options);
+    template <class Rule>
+    int trainVectorizedWith(const Rule& rule, int iterations, const ConvergenceOptions& options);
+    template <class Rule>
+    int trainParallelWith(const Rule& rule, int iterations, const ParallelOptions& parallel,
+                          const ConvergenceOptions& options);
+    // Timed = true só nas iterações amostradas pela telemetria (mede as fases).
+    template <class Rule, bool Timed = false>
+    double cfr(const Rule& rule, const int* cards, History history, double p0, double p1, int updatePlayer, double t);
+    template <class Rule>
+    void cfrVector(const Rule& rule, History history, int traverser, const double* strategy, const double* myReach,
+                   const double* oppReach, double t, double* values);
+    // Estratégia atual (regret matching) de todos os infosets.
+    void getCurrentStrategy(double* out);
 };
 
 /*
-Explicao do Cdigo
-Node struct:  o nosso "molde" para cada ponto de deciso.
+Explicação do Código
+Node struct: É o nosso "molde" para cada ponto de decisão.
 
-infoSet: Esta ser uma string nica que funciona como uma "impresso digital" do n (ex: "cartas do hero/cartas do board/histrico de apostas"). Usaremos um std::map<std::string, Node> para guardar todos os ns que encontrarmos, usando essa string como a chave. Isso evita ter que construir a rvore inteira na memria de uma vez.
+infoSet: A "impressão digital" do nó (ex: "carta/histórico de apostas") agora é só uma visão textual, gerada por InfoSetTable::name() para depuração e exportação. No treinamento, cada nó é identificado por um índice inteiro (InfoSetTable::index) e seus dados moram em arrays contíguos da InfoSetTable; o Node é apenas uma janela para essa linha da tabela.
 
-playerToAct: Simplesmente nos diz se  a vez do jogador 0 ou do jogador 1.
+playerToAct: Simplesmente nos diz se é a vez do jogador 0 ou do jogador 1.
 
-regretSum: Este  o corao do CFR.  um vetor (array) que armazena o "arrependimento" acumulado para cada ao possvel. Se regretSum[0] for muito alto, significa que o algoritmo se arrepende muito de no ter tomado a Ao 0 no passado.
+regretSum: Este é o coração do CFR. É um vetor (array) que armazena o "arrependimento" acumulado para cada ação possível. Se regretSum[0] for muito alto, significa que o algoritmo se arrepende muito de não ter tomado a Ação 0 no passado.
 
-strategySum: Para obter a estratgia GTO final, no usamos a estratgia de uma nica iterao, mas sim a mdia de todas as estratgias ao longo do tempo. Este vetor acumula essas probabilidades.
+strategySum: Para obter a estratégia GTO final, não usamos a estratégia de uma única iteração, mas sim a média de todas as estratégias ao longo do tempo. Este vetor acumula essas probabilidades.
 
-getStrategy(): Esta funo implementa a regra principal do CFR: a probabilidade de escolher uma ao  proporcional ao seu arrependimento positivo. Se uma ao no tem arrependimento positivo, ela no  escolhida (a menos que nenhuma ao tenha arrependimento, nesse caso, joga-se de forma aleatria).
+getStrategy(): Esta função implementa a regra principal do CFR: a probabilidade de escolher uma ação é proporcional ao seu arrependimento positivo. Se uma ação não tem arrependimento positivo, ela não é escolhida (a menos que nenhuma ação tenha arrependimento, nesse caso, joga-se de forma aleatória).
 
-getAverageStrategy(): Simplesmente calcula a mdia das estratgias salvas em strategySum para nos dar nosso resultado final.
+getAverageStrategy(): Simplesmente calcula a média das estratégias salvas em strategySum para nos dar nosso resultado final.
 */
 
 /*
-Explicao da Nova Classe
-CFRTrainer(): O construtor. Sua principal tarefa ser criar e embaralhar o baralho no incio de cada mo.
-
-train(int iterations): Esta ser a nica funo "pblica" que chamaremos de fora da classe. Ela ter um loop simples que rodar o processo de treinamento pelo nmero de iteraes que definirmos. Ex: for (int i = 0; i < iterations; i++) { ... }.
+Explicação da Nova Classe
+CFRTrainer(): O construtor. Só inicializa o gerador aleatório; o baralho é embaralhado no início de cada mão dentro de train().
 
-nodeMap: Como mencionei antes, este  o nosso "dicionrio" de ns. Quando chegarmos a um ponto do jogo, criaremos a string (infoSet) que o representa e verificaremos se ele j existe no nodeMap. Se no, criamos um novo Node e o adicionamos. Se sim, usamos o que j est l. Isso  muito mais eficiente do que gerar a rvore inteira.
+train(int iterations): Esta será a única função "pública" que chamaremos de fora da classe. Ela terá um loop simples que rodará o processo de treinamento pelo número de iterações que definirmos. Ex: for (int i = 0; i < iterations; i++) { ... }.
 
-deck: Um simples vetor de inteiros (std::vector<int>) que representa nosso baralho de 52 cartas.
+table: A InfoSetTable com os 12 infosets do Kuhn Poker. Antes usávamos um std::map<std::string, Node>, mas montar a string e buscar na árvore a cada chamada de cfr custava mais do que o próprio CFR. Agora o índice de cada nó é calculado direto a partir da carta e do histórico.
 
-cfr(...): Esta  a funo mais importante e complexa que escreveremos.
+cfr(...): Esta é a função mais importante e complexa que escreveremos.
 
- recursiva: ela chama a si mesma para explorar os galhos da rvore de deciso.
+É recursiva: ela chama a si mesma para explorar os galhos da árvore de decisão.
 
-cards: Guardar as cartas dos jogadores e do board.
+cards: Guardará as cartas dos jogadores e do board.
 
-history: A sequncia de aes que nos trouxe at este ponto.
+history: A sequência de ações que nos trouxe até este ponto.
 
-p0, p1: Parmetros cruciais do CFR chamados "reach probabilities" (probabilidades de alcance). p0  a probabilidade de que o jogador 0 jogue de uma forma que chegue a este n. p1  a mesma coisa para o jogador 1. Isso  essencial para ponderar corretamente os arrependimentos. No se preocupe, vamos detalhar isso quando formos implementar a funo.
+p0, p1: Parâmetros cruciais do CFR chamados "reach probabilities" (probabilidades de alcance). p0 é a probabilidade de que o jogador 0 jogue de uma forma que chegue a este nó. p1 é a mesma coisa para o jogador 1. Isso é essencial para ponderar corretamente os arrependimentos. Não se preocupe, vamos detalhar isso quando formos implementar a função.
 */
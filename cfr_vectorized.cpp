@@ -0,0 +1,362 @@
+// Arquivo: cfr_vectorized.cpp
+// CFR+ vetorizado: em vez de sortear uma distribuição de cartas por iteração,
+// cada nó da árvore pública recebe um vetor de probabilidades de alcance com
+// uma posição por carta privada, e os payoffs terminais viram pequenos
+// produtos matriz-vetor sobre todos os pares de cartas.
+// O cálculo de melhor resposta (exploitability) usa a mesma árvore e os mesmos kernels.
+
+#include "cfr_poker.h"
+#include "update_rules.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+namespace {
+
+// Matrizes terminais, já multiplicadas pela probabilidade de cada distribuição.
+// Formato [carta do oponente][minha carta], para que o loop interno percorra
+// posições contíguas. Linhas e colunas de padding ficam zeradas.
+struct TerminalMatrices {
+    alignas(32) double showdown[CARD_LANES][CARD_LANES]; // +p se eu venço, -p se perco
+    alignas(32) double fold[CARD_LANES][CARD_LANES];     // p para cada par de cartas distintas
+
+    TerminalMatrices() {
+        const double chance = 1.0 / (NUM_CARDS * (NUM_CARDS - 1));
+        for (int o = 0; o < CARD_LANES; ++o) {
+            for (int c = 0; c < CARD_LANES; ++c) {
+                bool valid = o < NUM_CARDS && c < NUM_CARDS && o != c;
+                showdown[o][c] = valid ? (c > o ? chance : -chance) : 0.0;
+                fold[o][c] = valid ? chance : 0.0;
+            }
+        }
+    }
+};
+
+const TerminalMatrices MATRICES;
+
+// values[c] = scale * soma_o matrix[o][c] * oppReach[o]
+inline void terminalKernel(const double (*matrix)[CARD_LANES], const double* oppReach, double scale,
+                           double* values) {
+    for (int c = 0; c < CARD_LANES; ++c) {
+        values[c] = 0.0;
+    }
+    for (int o = 0; o < CARD_LANES; ++o) {
+        const double r = scale * oppReach[o];
+        for (int c = 0; c < CARD_LANES; ++c) {
+            values[c] += matrix[o][c] * r;
+        }
+    }
+}
+
+inline void terminalValues(const HistoryInfo& info, int player, const double* oppReach, double* values) {
+    if (info.showdown != 0) {
+        terminalKernel(MATRICES.showdown, oppReach, info.showdown, values);
+    }
+    else {
+        terminalKernel(MATRICES.fold, oppReach, player == 0 ? info.foldPayoff : -info.foldPayoff, values);
+    }
+}
+
+// Regra do warm start por estratégia: uma única passada soma regretWeight
+// vezes o arrependimento instantâneo e strategyWeight vezes o alcance.
+struct WarmStartRule {
+    double regretWeight;
+    double strategyWeight;
+
+    double accumulateRegret(double regret, double delta, double) const { return regret + regretWeight * delta; }
+    double averagingWeight(double) const { return strategyWeight; }
+};
+
+} // namespace
+
+int CFRTrainer::trainVectorized(int iterations, const ConvergenceOptions& options) {
+    switch (updateRule.kind) {
+    case UpdateRule::VANILLA: return trainVectorizedWith(VanillaCFR(), iterations, options);
+    case UpdateRule::LINEAR: return trainVectorizedWith(LinearCFR(), iterations, options);
+    case UpdateRule::DISCOUNTED:
+        return trainVectorizedWith(DiscountedCFR{ updateRule.alpha, updateRule.beta, updateRule.gamma },
+                                   iterations, options);
+    default: return trainVectorizedWith(CFRPlus(), iterations, options);
+    }
+}
+
+template <class Rule>
+int CFRTrainer::trainVectorizedWith(const Rule& rule, int iterations, const ConvergenceOptions& options) {
+    alignas(32) double ones[CARD_LANES];
+    alignas(32) double values[CARD_LANES];
+    for (int c = 0; c < CARD_LANES; ++c) {
+        ones[c] = c < NUM_CARDS ? 1.0 : 0.0;
+    }
+    double strategy[NUM_INFOSETS * NUM_ACTIONS];
+
+    const int logInterval = iterations >= 10 ? iterations / 10 : 1;
+
+    if (verbose) {
+        std::cout << "Iniciando treinamento vetorizado (" << updateRule.name() << (updateRule.alternating ? ", alternado" : "")
+                  << ", todas as distribuicoes) por " << iterations << " iteracoes..." << std::endl;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    double gameValue = 0.0;
+    int i = 0;
+    while (i < iterations) {
+        // "t" conta desde o início do treinamento, para que um checkpoint retome igual.
+        const double t = static_cast<double>(totalIterations + 1);
+
+        // Simultâneo: os dois jogadores usam a estratégia do início da iteração.
+        // Alternado: o jogador 1 já joga contra a estratégia atualizada do jogador 0.
+        getCurrentStrategy(strategy);
+        for (int traverser = 0; traverser < NUM_PLAYERS; ++traverser) {
+            if (traverser > 0 && updateRule.alternating) {
+                getCurrentStrategy(strategy);
+            }
+            cfrVector(rule, ROOT_HISTORY, traverser, strategy, ones, ones, t, values);
+
+            if (traverser == 0) {
+                gameValue = 0.0;
+                for (int c = 0; c < NUM_CARDS; ++c) {
+                    gameValue += values[c];
+                }
+            }
+        }
+        rule.discount(table.regretSum, table.strategySum, NUM_INFOSETS * NUM_ACTIONS, t);
+
+        ++i;
+        ++totalIterations;
+        maybeCheckpoint(i);
+        if (verbose && i % logInterval == 0) {
+            std::cout << "Iteracao: " << i << ", Utilidade do Jogador 0: " << gameValue << std::endl;
+        }
+        if (options.checkInterval > 0 && i % options.checkInterval == 0) {
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (checkConvergence(i, elapsed.count(), options)) {
+                break;
+            }
+        }
+    }
+
+    if (verbose) {
+        std::cout << "Treinamento concluido apos " << i << " iteracoes." << std::endl;
+    }
+    return i;
+}
+
+// Percorre a árvore pública para "traverser". myReach e oppReach têm uma
+// posição por carta; values recebe a utilidade contrafactual de cada carta do
+// traverser (já ponderada pelo alcance do oponente e pelo acaso).
+// "strategy" é a estratégia atual de todos os infosets, calculada antes da passada.
+template <class Rule>
+void CFRTrainer::cfrVector(const Rule& rule, History history, int traverser, const double* strategy,
+                           const double* myReach, const double* oppReach, double t, double* values) {
+    const HistoryInfo& info = histories[history];
+
+    // Nós terminais: um produto matriz-vetor sobre todos os pares de cartas.
+    if (info.row < 0) {
+        terminalValues(info, traverser, oppReach, values);
+        return;
+    }
+
+    // Estratégia de cada carta, transposta para [ação][carta].
+    alignas(32) double cardStrategy[NUM_ACTIONS][CARD_LANES] = {};
+    for (int c = 0; c < NUM_CARDS; ++c) {
+        const double* s = &strategy[InfoSetTable::index(c, info.row) * NUM_ACTIONS];
+        for (int a = 0; a < NUM_ACTIONS; ++a) {
+            cardStrategy[a][c] = s[a];
+        }
+    }
+
+    alignas(32) double childValues[NUM_ACTIONS][CARD_LANES];
+    alignas(32) double childReach[CARD_LANES];
+
+    if (info.player != traverser) {
+        // O oponente age: seu alcance é dividido entre as ações e os valores somados.
+        for (int c = 0; c < CARD_LANES; ++c) {
+            values[c] = 0.0;
+        }
+        for (int a = 0; a < NUM_ACTIONS; ++a) {
+            for (int c = 0; c < CARD_LANES; ++c) {
+                childReach[c] = oppReach[c] * cardStrategy[a][c];
+            }
+            cfrVector(rule, nextHistory(history, a), traverser, strategy, myReach, childReach, t, childValues[a]);
+            for (int c = 0; c < CARD_LANES; ++c) {
+                values[c] += childValues[a][c];
+            }
+        }
+        return;
+    }
+
+    for (int c = 0; c < CARD_LANES; ++c) {
+        values[c] = 0.0;
+    }
+    for (int a = 0; a < NUM_ACTIONS; ++a) {
+        for (int c = 0; c < CARD_LANES; ++c) {
+            childReach[c] = myReach[c] * cardStrategy[a][c];
+        }
+        cfrVector(rule, nextHistory(history, a), traverser, strategy, childReach, oppReach, t, childValues[a]);
+        for (int c = 0; c < CARD_LANES; ++c) {
+            values[c] += cardStrategy[a][c] * childValues[a][c];
+        }
+    }
+
+    // Atualização de cada infoset deste histórico, conforme a regra.
+    const double weight = rule.averagingWeight(t);
+    for (int c = 0; c < NUM_CARDS; ++c) {
+        Node node = table.node(InfoSetTable::index(c, info.row));
+        for (int a = 0; a < NUM_ACTIONS; ++a) {
+            node.regretSum[a] = rule.accumulateRegret(node.regretSum[a], childValues[a][c] - values[c], t);
+            node.strategySum[a] += weight * myReach[c] * cardStrategy[a][c];
+        }
+    }
+}
+
+void CFRTrainer::warmStart(const double* strategy, const WarmStartOptions& options) {
+    alignas(32) double ones[CARD_LANES];
+    alignas(32) double values[CARD_LANES];
+    for (int c = 0; c < CARD_LANES; ++c) {
+        ones[c] = c < NUM_CARDS ? 1.0 : 0.0;
+    }
+
+    // Soma dos pesos de n iterações na regra atual: o CFR+ pondera a média
+    // por t e o Linear CFR pondera média e arrependimentos por t.
+    const double n = options.strategyIterations > 0 ? options.strategyIterations : 0;
+    const double triangular = n * (n + 1) / 2;
+    const UpdateRule::Kind kind = updateRule.kind;
+    const WarmStartRule rule{ kind == UpdateRule::LINEAR ? triangular : n,
+                              kind == UpdateRule::CFR_PLUS || kind == UpdateRule::LINEAR ? triangular : n };
+
+    table = InfoSetTable();
+    for (int traverser = 0; traverser < NUM_PLAYERS; ++traverser) {
+        cfrVector(rule, ROOT_HISTORY, traverser, strategy, ones, ones, 0.0, values);
+    }
+    if (kind == UpdateRule::CFR_PLUS) {
+        for (double& regret : table.regretSum) {
+            regret = std::max(regret, 0.0);
+        }
+    }
+    totalIterations = static_cast<long long>(n);
+}
+
+bool CFRTrainer::solveSubgame(const SubgameQuery& query, SubgameSolution& solution) {
+    const int rootRow = InfoSetTable::historyIndex(query.root);
+    if (rootRow < 0 || (query.maxIterations <= 0 && query.maxSeconds <= 0)) {
+        return false;
+    }
+
+    alignas(32) double reach[NUM_PLAYERS][CARD_LANES] = {};
+    alignas(32) double values[CARD_LANES];
+    for (int p = 0; p < NUM_PLAYERS; ++p) {
+        for (int c = 0; c < NUM_CARDS; ++c) {
+            reach[p][c] = query.ranges[p][c];
+        }
+    }
+    double strategy[NUM_INFOSETS * NUM_ACTIONS];
+    const CFRPlus rule;
+
+    table = InfoSetTable();
+    auto start = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed(0.0);
+    int i = 0;
+    while (query.maxIterations <= 0 || i < query.maxIterations) {
+        const double t = static_cast<double>(i + 1);
+        for (int traverser = 0; traverser < NUM_PLAYERS; ++traverser) {
+            getCurrentStrategy(strategy);
+            cfrVector(rule, query.root, traverser, strategy, reach[traverser], reach[1 - traverser], t, values);
+        }
+        ++i;
+        if (query.maxSeconds > 0) {
+            elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= query.maxSeconds) {
+                break;
+            }
+        }
+    }
+    if (query.maxSeconds <= 0) {
+        elapsed = std::chrono::steady_clock::now() - start;
+    }
+
+    for (int c = 0; c < NUM_CARDS; ++c) {
+        table.node(InfoSetTable::index(c, rootRow)).getAverageStrategy(solution.strategy[c]);
+    }
+    solution.iterations = i;
+    solution.seconds = elapsed.count();
+    totalIterations = i;
+    return true;
+}
+
+double CFRTrainer::exploitability() {
+    alignas(32) double ones[CARD_LANES];
+    alignas(32) double values[CARD_LANES];
+    for (int c = 0; c < CARD_LANES; ++c) {
+        ones[c] = c < NUM_CARDS ? 1.0 : 0.0;
+    }
+
+    double total = 0.0;
+    for (int responder = 0; responder < NUM_PLAYERS; ++responder) {
+        bestResponse(ROOT_HISTORY, responder, ones, values);
+        for (int c = 0; c < NUM_CARDS; ++c) {
+            total += values[c];
+        }
+    }
+
+    // O valor do jogo se cancela na soma das duas melhores respostas.
+    return total / NUM_PLAYERS * 1000.0;
+}
+
+bool CFRTrainer::checkConvergence(int iteration, double seconds, const ConvergenceOptions& options) {
+    double mbb = exploitability();
+    convergence.push_back({ iteration, seconds, mbb });
+    if (verbose) {
+        std::cout << "Iteracao: " << iteration << ", Exploitability: " << mbb << " mbb/mao" << std::endl;
+    }
+    return options.targetMbb > 0 && mbb <= options.targetMbb;
+}
+
+// Melhor resposta de "responder" contra a estratégia média do oponente.
+// values recebe o valor de cada carta do responder, como em cfrVector.
+void CFRTrainer::bestResponse(History history, int responder, const double* oppReach, double* values) {
+    const HistoryInfo& info = histories[history];
+
+    if (info.row < 0) {
+        terminalValues(info, responder, oppReach, values);
+        return;
+    }
+
+    alignas(32) double childValues[NUM_ACTIONS][CARD_LANES];
+
+    if (info.player == responder) {
+        // Cada carta escolhe a ação de maior valor.
+        for (int a = 0; a < NUM_ACTIONS; ++a) {
+            bestResponse(nextHistory(history, a), responder, oppReach, childValues[a]);
+        }
+        for (int c = 0; c < CARD_LANES; ++c) {
+            values[c] = childValues[0][c];
+            for (int a = 1; a < NUM_ACTIONS; ++a) {
+                values[c] = std::max(values[c], childValues[a][c]);
+            }
+        }
+        return;
+    }
+
+    alignas(32) double strategy[NUM_ACTIONS][CARD_LANES] = {};
+    for (int c = 0; c < NUM_CARDS; ++c) {
+        double s[NUM_ACTIONS];
+        table.node(InfoSetTable::index(c, info.row)).getAverageStrategy(s);
+        for (int a = 0; a < NUM_ACTIONS; ++a) {
+            strategy[a][c] = s[a];
+        }
+    }
+
+    alignas(32) double childReach[CARD_LANES];
+    for (int c = 0; c < CARD_LANES; ++c) {
+        values[c] = 0.0;
+    }
+    for (int a = 0; a < NUM_ACTIONS; ++a) {
+        for (int c = 0; c < CARD_LANES; ++c) {
+            childReach[c] = oppReach[c] * strategy[a][c];
+        }
+        bestResponse(nextHistory(history, a), responder, childReach, childValues[a]);
+        for (int c = 0; c < CARD_LANES; ++c) {
+            values[c] += childValues[a][c];
+        }
+    }
+}
@@ -0,0 +1,214 @@
+// Arquivo: dataset.cpp
+
+#include "dataset.h"
+#include "rng.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+DatasetWriter::DatasetWriter()
+    : features(0), actions(0), recordFloats(0), mask(0), enqueuePos(0), dequeuePos(0), stopping(false),
+      droppedRecords(0), seenRecords(0), appendChunk(-1), appendPosition(false), rngState(0) {
+}
+
+DatasetWriter::~DatasetWriter() {
+    close();
+}
+
+bool DatasetWriter::open(const std::string& path, int numFeatures, int numActions, const DatasetOptions& opts) {
+    close();
+    if (numFeatures <= 0 || numActions <= 0 || opts.chunkRecords <= 0) {
+        std::cerr << "Dataset com dimensoes invalidas." << std::endl;
+        return false;
+    }
+    prefix = path;
+    options = opts;
+    features = numFeatures;
+    actions = numActions;
+    recordFloats = numFeatures + 2 * numActions;
+
+    uint64_t capacity = 1;
+    while (capacity < static_cast<uint64_t>(opts.queueCapacity > 1 ? opts.queueCapacity : 2)) {
+        capacity <<= 1;
+    }
+    mask = capacity - 1;
+    sequence.reset(new std::atomic<uint64_t>[capacity]);
+    for (uint64_t i = 0; i < capacity; ++i) {
+        sequence[i].store(i, std::memory_order_relaxed);
+    }
+    slots.assign(capacity * recordFloats, 0.0f);
+    enqueuePos.store(0);
+    dequeuePos = 0;
+
+    chunks.clear();
+    chunkCounts.clear();
+    appendChunk = -1;
+    appendPosition = false;
+    rngState = opts.seed;
+    stopping.store(false);
+    droppedRecords.store(0);
+    seenRecords.store(0);
+
+    // O primeiro arquivo já é criado aqui, para que erros de caminho apareçam no open().
+    if (!chunkFile(0)) {
+        return false;
+    }
+    appendChunk = 0;
+    appendPosition = true;
+    writer = std::thread(&DatasetWriter::run, this);
+    return true;
+}
+
+void DatasetWriter::close() {
+    if (writer.joinable()) {
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+    }
+}
+
+bool DatasetWriter::push(const double* featureValues, const double* strategy, const double* advantages) {
+    uint64_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        const uint64_t seq = sequence[pos & mask].load(std::memory_order_acquire);
+        const int64_t diff = static_cast<int64_t>(seq - pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            droppedRecords.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    float* slot = &slots[(pos & mask) * recordFloats];
+    for (int i = 0; i < features; ++i) {
+        slot[i] = static_cast<float>(featureValues[i]);
+    }
+    for (int a = 0; a < actions; ++a) {
+        slot[features + a] = static_cast<float>(strategy[a]);
+        slot[features + actions + a] = static_cast<float>(advantages[a]);
+    }
+    sequence[pos & mask].store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+void DatasetWriter::run() {
+    std::vector<float> record(recordFloats);
+    for (;;) {
+        // Lê "stopping" antes de esvaziar: depois do sinal, uma última passada pega o que restou.
+        const bool stop = stopping.load(std::memory_order_acquire);
+        bool idle = true;
+        for (;;) {
+            std::atomic<uint64_t>& seq = sequence[dequeuePos & mask];
+            if (seq.load(std::memory_order_acquire) != dequeuePos + 1) {
+                break;
+            }
+            std::memcpy(record.data(), &slots[(dequeuePos & mask) * recordFloats], recordFloats * sizeof(float));
+            seq.store(dequeuePos + mask + 1, std::memory_order_release);
+            ++dequeuePos;
+            store(record.data());
+            idle = false;
+        }
+        if (stop) {
+            break;
+        }
+        if (idle) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    for (int chunk = 0; chunk < static_cast<int>(chunks.size()); ++chunk) {
+        if (chunks[chunk]) {
+            writeHeader(chunk);
+            chunks[chunk].reset();
+        }
+    }
+}
+
+// Reservatório: os primeiros maxRecords registros entram em ordem; depois,
+// o registro n (contando de 0) substitui a posição j sorteada em [0, n] se j < maxRecords.
+void DatasetWriter::store(const float* record) {
+    const uint64_t n = static_cast<uint64_t>(seenRecords.fetch_add(1, std::memory_order_relaxed));
+    const uint64_t limit = static_cast<uint64_t>(options.maxRecords);
+    const bool append = options.maxRecords <= 0 || n < limit;
+    const uint64_t slot = append ? n : splitMix64(rngState) % (n + 1);
+    if (!append && slot >= limit) {
+        return;
+    }
+
+    const int chunk = static_cast<int>(slot / options.chunkRecords);
+    const std::streamoff offset = DATASET_HEADER_BYTES +
+        static_cast<std::streamoff>(slot % options.chunkRecords) * recordFloats * sizeof(float);
+    if (append && chunk != appendChunk) {
+        // Arquivo anterior completo. Sem teto ele não muda mais e já pode ser fechado.
+        writeHeader(appendChunk);
+        if (options.maxRecords <= 0) {
+            chunks[appendChunk].reset();
+        }
+        appendChunk = chunk;
+        appendPosition = false;
+    }
+    std::fstream* file = chunkFile(chunk);
+    if (!file) {
+        return;
+    }
+    if (!append || !appendPosition) {
+        file->seekp(offset);
+    }
+    file->write(reinterpret_cast<const char*>(record), recordFloats * sizeof(float));
+    if (append) {
+        ++chunkCounts[chunk];
+        appendPosition = true;
+    }
+    else if (chunk == appendChunk) {
+        appendPosition = false;
+    }
+}
+
+std::fstream* DatasetWriter::chunkFile(int chunk) {
+    if (chunk < static_cast<int>(chunks.size()) && chunks[chunk]) {
+        return chunks[chunk].get();
+    }
+    if (chunk >= static_cast<int>(chunks.size())) {
+        chunks.resize(chunk + 1);
+        chunkCounts.resize(chunk + 1, 0);
+    }
+    char suffix[16];
+    std::snprintf(suffix, sizeof(suffix), ".%05d.kds", chunk);
+    const std::string path = prefix + suffix;
+    std::unique_ptr<std::fstream> file(
+        new std::fstream(path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc));
+    if (!*file) {
+        std::cerr << "Erro ao criar o arquivo do dataset: " << path << std::endl;
+        return nullptr;
+    }
+    chunks[chunk] = std::move(file);
+    writeHeader(chunk);
+    if (chunk == appendChunk) {
+        appendPosition = false;
+    }
+    return chunks[chunk].get();
+}
+
+void DatasetWriter::writeHeader(int chunk) {
+    if (chunk < 0 || !chunks[chunk]) {
+        return;
+    }
+    char header[DATASET_HEADER_BYTES] = {};
+    const uint32_t dims[4] = { DATASET_VERSION, static_cast<uint32_t>(features), static_cast<uint32_t>(actions), 0 };
+    const uint64_t counts[2] = { chunkCounts[chunk], static_cast<uint64_t>(chunk) };
+    std::memcpy(header, DATASET_MAGIC, sizeof(DATASET_MAGIC));
+    std::memcpy(header + 8, dims, sizeof(dims));
+    std::memcpy(header + 24, counts, sizeof(counts));
+    chunks[chunk]->seekp(0);
+    chunks[chunk]->write(header, sizeof(header));
+    if (chunk == appendChunk) {
+        appendPosition = false;
+    }
+}
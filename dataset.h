@@ -0,0 +1,105 @@
+#pragma once
+// Arquivo: dataset.h
+// Gerador de datasets para o treino de redes: registros (features, estratégia
+// média, vantagens) amostrados durante a travessia, para jogos em que o CSV
+// de um infoset por linha do exportCSV() não serve.
+//
+// As threads de travessia chamam push(), que só copia o registro para uma fila
+// circular limitada e sem locks (a fila de Vyukov: cada posição tem um número
+// de sequência, e produtores disputam a posição com um compare-exchange). Se a
+// fila estiver cheia o registro é descartado e contado; o treino nunca espera
+// pelo disco. Uma thread de escrita esvazia a fila para os arquivos.
+//
+// Com maxRecords > 0 o dataset é um reservatório (algoritmo R): os primeiros
+// maxRecords registros são gravados em ordem, e depois o n-ésimo substitui uma
+// posição sorteada com probabilidade maxRecords / n. O tamanho em disco fica
+// limitado e o conteúdo é uma amostra uniforme de tudo o que foi gerado.
+//
+// Arquivos: PREFIXO.00000.kds, PREFIXO.00001.kds... com chunkRecords registros
+// cada, pensados para numpy.memmap (kuhn_dataset.py), little-endian:
+//
+//   char     magic[8]      "KUHNDS"
+//   uint32   version       DATASET_VERSION
+//   uint32   numFeatures
+//   uint32   numActions
+//   uint32   reserved
+//   uint64   numRecords    registros válidos neste arquivo
+//   uint64   chunk         índice do arquivo
+//   (zeros até DATASET_HEADER_BYTES)
+//   float    registros[numRecords][numFeatures + 2 * numActions]
+//            (features, estratégia média, vantagens)
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+const uint32_t DATASET_VERSION = 1;
+const char DATASET_MAGIC[8] = { 'K', 'U', 'H', 'N', 'D', 'S', '\0', '\0' };
+const int DATASET_HEADER_BYTES = 64;
+
+struct DatasetOptions {
+    long long maxRecords = 0;     // Teto do reservatório (0 = grava tudo)
+    int chunkRecords = 1 << 20;   // Registros por arquivo
+    int queueCapacity = 1 << 16;  // Arredondado para potência de 2
+    uint64_t seed = 0;            // Sorteios do reservatório
+};
+
+class DatasetWriter {
+public:
+    DatasetWriter();
+    ~DatasetWriter();
+    DatasetWriter(const DatasetWriter&) = delete;
+    DatasetWriter& operator=(const DatasetWriter&) = delete;
+
+    // Aloca a fila e inicia a thread de escrita; push() nunca aloca.
+    bool open(const std::string& prefix, int numFeatures, int numActions,
+              const DatasetOptions& options = DatasetOptions());
+    // Esvazia a fila, atualiza os cabeçalhos, encerra a thread e fecha os arquivos.
+    void close();
+    bool isOpen() const { return writer.joinable(); }
+
+    // Seguro de qualquer thread. strategy e advantages têm numActions posições.
+    // Devolve false se a fila estava cheia e o registro foi descartado.
+    bool push(const double* features, const double* strategy, const double* advantages);
+
+    int numFeatures() const { return features; }
+    long long dropped() const { return droppedRecords.load(std::memory_order_relaxed); }
+    // Registros que passaram pela fila (o reservatório guarda no máximo maxRecords).
+    long long seen() const { return seenRecords.load(std::memory_order_relaxed); }
+
+private:
+    std::string prefix;
+    DatasetOptions options;
+    int features;
+    int actions;
+    int recordFloats;
+
+    // Fila: slots[pos & mask] guarda o registro e sequence[pos & mask] diz de
+    // quem é a vez (pos = livre para o produtor, pos + 1 = pronto para a escrita).
+    std::unique_ptr<std::atomic<uint64_t>[]> sequence;
+    std::vector<float> slots;
+    uint64_t mask;
+    std::atomic<uint64_t> enqueuePos;
+    uint64_t dequeuePos;
+
+    std::atomic<bool> stopping;
+    std::atomic<long long> droppedRecords;
+    std::atomic<long long> seenRecords;
+    std::thread writer;
+
+    // Estado da thread de escrita.
+    std::vector<std::unique_ptr<std::fstream>> chunks;
+    std::vector<uint64_t> chunkCounts;
+    int appendChunk;      // Arquivo que recebe os registros em ordem
+    bool appendPosition;  // O ponteiro de escrita desse arquivo está no fim
+    uint64_t rngState;
+
+    void run();
+    void store(const float* record);
+    std::fstream* chunkFile(int chunk);
+    void writeHeader(int chunk);
+};
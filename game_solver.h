@@ -0,0 +1,546 @@
+#pragma once
+// Arquivo: game_solver.h
+// Núcleo de CFR genérico sobre descritores de jogo (games.h).
+//
+// GameSolver<Game, Rule> é instanciado uma vez por jogo: a árvore de apostas
+// é uma tabela constexpr, e a travessia é um template sobre o id do nó, então
+// o compilador gera uma função especializada (e em geral inlinada) para cada
+// nó da árvore, com o número de ações e os filhos conhecidos em tempo de
+// compilação. As tabelas de arrependimento e de estratégia são densas,
+// indexadas por infoset = infoSetBase do nó + bucket da mão.
+//
+// O CFRTrainer continua sendo o caminho otimizado do Kuhn de 3 cartas (modo
+// vetorizado, threads, checkpoints); GameSolver<KuhnGame<3>> resolve o mesmo
+// jogo e serve de referência cruzada.
+//
+// Três modos de amostragem (Lanctot et al., "Monte Carlo Sampling for Regret
+// Minimization in Extensive Games"), todos com atualizações alternadas:
+//   CHANCE_SAMPLING   sorteia a distribuição e percorre todas as ações
+//   EXTERNAL_SAMPLING sorteia a distribuição e as ações do oponente; o
+//                     jogador atualizado percorre todas as suas
+//   OUTCOME_SAMPLING  sorteia uma única história terminal por iteração, com
+//                     exploração epsilon nas ações do jogador atualizado
+// O gerador é o Philox4x32 do rng.h, então (semente, fluxo) determina a
+// sequência de amostras.
+//
+// Com setDataset(), uma a cada "every" atualizações de infoset vira um
+// registro do dataset (dataset.h): features (one-hot do bucket seguido do
+// one-hot do nó de decisão), estratégia média e as vantagens da iteração, o
+// incremento de arrependimento antes da regra.
+//
+// Com mais de dois jogadores nada muda na forma da travessia: as utilidades
+// são sempre as do jogador atualizado (o jogo não precisa ser de soma zero
+// entre dois), e o alcance vai em dois números, o do jogador atualizado e o
+// alcance contrafactual, produto do acaso e de todos os oponentes. Como as
+// atualizações são alternadas, é tudo o que a regra usa, e o caminho de dois
+// jogadores continua com o mesmo custo.
+//
+// O terceiro parâmetro escolhe o armazenamento das tabelas (regret_storage.h):
+// double por padrão, float ou inteiros com escala por infoset. A travessia
+// sempre calcula em double e lê/grava uma linha inteira por infoset.
+
+#include "dataset.h"
+#include "games.h"
+#include "regret_storage.h"
+#include "rng.h"
+#include "update_rules.h"
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+enum Sampling { CHANCE_SAMPLING, EXTERNAL_SAMPLING, OUTCOME_SAMPLING };
+
+template <class Game, class Rule = CFRPlus, class Table = PlainTable<double>>
+class GameSolver {
+public:
+    static constexpr int NUM_PLAYERS = Game::NUM_PLAYERS;
+    static constexpr int NUM_ACTIONS = Game::NUM_ACTIONS;
+    static_assert(NUM_ACTIONS <= Table::MAX_ACTIONS, "a tabela não comporta NUM_ACTIONS ações por infoset");
+    static constexpr int NUM_INFOSETS = Game::NUM_INFOSETS;
+    static constexpr int TABLE_SIZE = NUM_INFOSETS * NUM_ACTIONS;
+    // Probabilidade de sortear uniformemente no outcome sampling.
+    static constexpr double OUTCOME_EXPLORATION = 0.6;
+    // Iterações entre chamadas de Table::rescale().
+    static constexpr int RESCALE_PERIOD = 1024;
+
+    // Tamanho das features do dataset: maior número de buckets de uma rodada
+    // mais o número de nós de decisão da árvore.
+    static constexpr int maxBuckets() {
+        int most = 0;
+        for (int r = 0; r < MAX_GAME_ROUNDS; ++r) {
+            most = Game::BUCKETS[r] > most ? Game::BUCKETS[r] : most;
+        }
+        return most;
+    }
+    static constexpr int decisionsBefore(int n) {
+        int count = 0;
+        for (int i = 0; i < n; ++i) {
+            count += Game::TREE.nodes[i].player >= 0 ? 1 : 0;
+        }
+        return count;
+    }
+    static constexpr int NUM_BUCKET_FEATURES = maxBuckets();
+    static constexpr int NUM_FEATURES = NUM_BUCKET_FEATURES + decisionsBefore(Game::TREE.numNodes);
+
+    explicit GameSolver(uint64_t seed = 0, const Rule& rule = Rule(), Sampling sampling = CHANCE_SAMPLING,
+                        uint64_t stream = 0)
+        : rule(rule), sampling(sampling), rng(seed, stream), totalIterations(0), table(NUM_INFOSETS, NUM_ACTIONS),
+          dataset(nullptr), datasetEvery(1), datasetCountdown(1) {}
+
+    // Uma iteração por jogador atualizado, no modo de amostragem escolhido.
+    // Devolve a média das estimativas de utilidade do jogador 0 nas
+    // iterações em que ele foi o atualizado.
+    double train(int iterations) {
+        constexpr auto players = std::make_integer_sequence<int, NUM_PLAYERS>();
+        double utility = 0.0;
+        int samples = 0;
+        for (int i = 0; i < iterations; ++i) {
+            const Deal deal = Game::deal(static_cast<int>(rng.nextBelow(Game::NUM_DEALS)));
+            const double t = static_cast<double>(totalIterations + 1);
+            const int updatePlayer = static_cast<int>(totalIterations % NUM_PLAYERS);
+            const double value = withPlayer(players, updatePlayer, [&](auto player) {
+                constexpr int P = decltype(player)::value;
+                if (sampling == EXTERNAL_SAMPLING) {
+                    return traverseExternal<0, P>(deal, t);
+                }
+                if (sampling == OUTCOME_SAMPLING) {
+                    return traverseOutcome<0, P>(deal, 1.0, 1.0, 1.0, t);
+                }
+                return traverse<0, P>(deal, 1.0, 1.0, t);
+            });
+            if (updatePlayer == 0) {
+                utility += value;
+                ++samples;
+            }
+            table.discount(rule, t);
+            ++totalIterations;
+            if (totalIterations % RESCALE_PERIOD == 0) {
+                table.rescale();
+            }
+        }
+        return samples > 0 ? utility / samples : 0.0;
+    }
+
+    // Exploitability da estratégia média em mbb/mão: média dos ganhos das
+    // melhores respostas de cada jogador, calculadas com exatidão sobre todas
+    // as distribuições. Como os jogos são de soma zero, os valores das
+    // estratégias se cancelam na soma e sobra a média dos ganhos (NashConv / N).
+    double exploitability() const {
+        std::vector<double> reach(Game::NUM_DEALS, 1.0 / Game::NUM_DEALS);
+        double total = 0.0;
+        for (int responder = 0; responder < NUM_PLAYERS; ++responder) {
+            std::vector<double> values = bestResponse(0, responder, reach);
+            for (double v : values) {
+                total += v;
+            }
+        }
+        return total / NUM_PLAYERS * 1000.0;
+    }
+
+    // Valor esperado exato do jogo para o jogador 0 com as estratégias médias.
+    double gameValue() const {
+        double value = 0.0;
+        for (int d = 0; d < Game::NUM_DEALS; ++d) {
+            value += expectedValue(0, Game::deal(d));
+        }
+        return value / Game::NUM_DEALS;
+    }
+
+    void getAverageStrategy(int infoSet, double* out) const {
+        averageStrategy(infoSet, numActionsOf(infoSet), out);
+    }
+
+    // Nome legível do infoset: "bucket/histórico", como "2/pb" no Kuhn.
+    std::string infoSetName(int infoSet) const {
+        const TreeNode& node = nodeOf(infoSet);
+        return std::to_string(infoSet - node.infoSetBase) + "/" + node.history;
+    }
+
+    long long getIterations() const { return totalIterations; }
+    Sampling getSampling() const { return sampling; }
+    size_t bytesPerInfoSet() const { return table.bytesPerInfoSet(); }
+
+    // O writer precisa ter sido aberto com NUM_FEATURES e NUM_ACTIONS; nullptr desliga.
+    void setDataset(DatasetWriter* writer, int every = 1) {
+        dataset = writer;
+        datasetEvery = every > 0 ? every : 1;
+        datasetCountdown = datasetEvery;
+    }
+
+private:
+    Rule rule;
+    Sampling sampling;
+    Philox4x32 rng;
+    long long totalIterations;
+    Table table;
+    DatasetWriter* dataset;
+    int datasetEvery;
+    int datasetCountdown;
+
+    static constexpr const auto& TREE = Game::TREE;
+
+    // Utilidade de "player" num terminal: a parte do pote que ele leva menos o
+    // que colocou. O pote é dividido entre os ativos com a mão mais forte; num
+    // fold sobra um único ativo, que leva tudo.
+    static double payoff(const TreeNode& node, const Deal& deal, int player) {
+        if constexpr (NUM_PLAYERS == 2) {
+            // Soma zero entre dois: calcula a do jogador 0 e troca o sinal.
+            double value;
+            if (node.active == 1) {
+                value = node.folded == 1 ? -node.contribution[0] : node.contribution[1];
+            }
+            else {
+                const int s0 = Game::strength(deal, 0);
+                const int s1 = Game::strength(deal, 1);
+                value = s0 > s1 ? node.contribution[1] : (s0 < s1 ? -node.contribution[0] : 0.0);
+            }
+            return player == 0 ? value : -value;
+        }
+        int pot = 0;
+        for (int p = 0; p < NUM_PLAYERS; ++p) {
+            pot += node.contribution[p];
+        }
+        if (node.folded >> player & 1) {
+            return -node.contribution[player];
+        }
+        if (node.active == 1) {
+            return pot - node.contribution[player];
+        }
+        const int mine = Game::strength(deal, player);
+        int winners = 0;
+        for (int p = 0; p < NUM_PLAYERS; ++p) {
+            if (!(node.folded >> p & 1)) {
+                const int strength = Game::strength(deal, p);
+                if (strength > mine) {
+                    return -node.contribution[player];
+                }
+                winners += strength == mine ? 1 : 0;
+            }
+        }
+        return (winners == 1 ? pot : static_cast<double>(pot) / winners) - node.contribution[player];
+    }
+
+    static int infoSetOf(const TreeNode& node, const Deal& deal, int player) {
+        return node.infoSetBase + Game::bucket(deal, player, node.round);
+    }
+
+    static const TreeNode& nodeOf(int infoSet) {
+        int best = 0;
+        for (int n = 0; n < TREE.numNodes; ++n) {
+            if (TREE.nodes[n].player >= 0 && TREE.nodes[n].infoSetBase <= infoSet) {
+                best = n;
+            }
+        }
+        return TREE.nodes[best];
+    }
+
+    static int numActionsOf(int infoSet) { return nodeOf(infoSet).numActions; }
+
+    // Regret matching sobre os arrependimentos positivos da linha.
+    static void currentStrategy(const double* regret, int numActions, double* strategy) {
+        double normalizingSum = 0.0;
+        for (int a = 0; a < numActions; ++a) {
+            strategy[a] = regret[a] > 0 ? regret[a] : 0.0;
+            normalizingSum += strategy[a];
+        }
+        for (int a = 0; a < numActions; ++a) {
+            strategy[a] = normalizingSum > 0 ? strategy[a] / normalizingSum : 1.0 / numActions;
+        }
+    }
+
+    void averageStrategy(int infoSet, int numActions, double* strategy) const {
+        double sum[NUM_ACTIONS];
+        table.getStrategySum(infoSet, numActions, sum);
+        double normalizingSum = 0.0;
+        for (int a = 0; a < numActions; ++a) {
+            normalizingSum += sum[a];
+        }
+        for (int a = 0; a < numActions; ++a) {
+            strategy[a] = normalizingSum > 0 ? sum[a] / normalizingSum : 1.0 / numActions;
+        }
+    }
+
+    // Chama f com o jogador atualizado como constante de compilação: cada
+    // travessia é instanciada por jogador, e os testes "este nó é dele?" somem.
+    template <class F, int... P>
+    static double withPlayer(std::integer_sequence<int, P...>, int player, F&& f) {
+        double result = 0.0;
+        ((player == P ? (result = f(std::integral_constant<int, P>()), true) : false) || ...);
+        return result;
+    }
+
+    // Travessia do CFR. Devolve a utilidade do jogador atualizado P a partir
+    // do nó N; myReach é o alcance dele e oppReach o alcance contrafactual.
+    template <int N, int P>
+    double traverse(const Deal& deal, double myReach, double oppReach, double t) {
+        constexpr TreeNode node = TREE.nodes[N];
+        if constexpr (node.player < 0) {
+            return payoff(TREE.nodes[N], deal, P);
+        }
+        else {
+            constexpr int player = node.player;
+            const int infoSet = infoSetOf(node, deal, player);
+            double regret[NUM_ACTIONS];
+            double strategy[NUM_ACTIONS];
+            double actionUtils[NUM_ACTIONS];
+            table.getRegrets(infoSet, node.numActions, regret);
+            currentStrategy(regret, node.numActions, strategy);
+            visitChildren<N, P>(std::make_integer_sequence<int, node.numActions>(), deal, myReach, oppReach, t,
+                                strategy, actionUtils);
+
+            double nodeUtility = 0.0;
+            for (int a = 0; a < node.numActions; ++a) {
+                nodeUtility += strategy[a] * actionUtils[a];
+            }
+
+            if constexpr (player == P) {
+                const double weight = rule.averagingWeight(t);
+                double advantages[NUM_ACTIONS];
+                double contribution[NUM_ACTIONS];
+                for (int a = 0; a < node.numActions; ++a) {
+                    advantages[a] = oppReach * (actionUtils[a] - nodeUtility);
+                    regret[a] = rule.accumulateRegret(regret[a], advantages[a], t);
+                    contribution[a] = weight * myReach * strategy[a];
+                }
+                table.setRegrets(infoSet, node.numActions, regret);
+                table.addStrategy(infoSet, node.numActions, contribution);
+                if (dataset) {
+                    recordSample<N>(infoSet, advantages);
+                }
+            }
+            return nodeUtility;
+        }
+    }
+
+    template <int N, int P, int... A>
+    void visitChildren(std::integer_sequence<int, A...>, const Deal& deal, double myReach, double oppReach, double t,
+                       const double* strategy, double* actionUtils) {
+        constexpr TreeNode node = TREE.nodes[N];
+        constexpr bool updating = node.player == P;
+        ((actionUtils[A] = traverse<node.children[A], P>(deal, updating ? myReach * strategy[A] : myReach,
+                                                         updating ? oppReach : oppReach * strategy[A], t)),
+         ...);
+    }
+
+    // Registro do dataset para o infoset recém-atualizado no nó N.
+    template <int N>
+    void recordSample(int infoSet, const double* advantages) {
+        if (--datasetCountdown > 0) {
+            return;
+        }
+        datasetCountdown = datasetEvery;
+        constexpr TreeNode node = TREE.nodes[N];
+        double features[NUM_FEATURES] = {};
+        features[infoSet - node.infoSetBase] = 1.0;
+        features[NUM_BUCKET_FEATURES + decisionsBefore(N)] = 1.0;
+        double strategy[NUM_ACTIONS] = {};
+        double padded[NUM_ACTIONS] = {};
+        averageStrategy(infoSet, node.numActions, strategy);
+        for (int a = 0; a < node.numActions; ++a) {
+            padded[a] = advantages[a];
+        }
+        dataset->push(features, strategy, padded);
+    }
+
+    // Sorteia uma ação segundo a distribuição "probs".
+    int sampleAction(const double* probs, int numActions) {
+        double u = rng.nextDouble();
+        for (int a = 0; a < numActions - 1; ++a) {
+            u -= probs[a];
+            if (u < 0) {
+                return a;
+            }
+        }
+        return numActions - 1;
+    }
+
+    // Chama f com o id do filho "action" do nó N como constante de compilação:
+    // a ação sorteada em tempo de execução cai na travessia especializada.
+    template <int N, class F, int... A>
+    static double withChild(std::integer_sequence<int, A...>, int action, F&& f) {
+        constexpr TreeNode node = TREE.nodes[N];
+        double result = 0.0;
+        ((action == A ? (result = f(std::integral_constant<int, node.children[A]>()), true) : false) || ...);
+        return result;
+    }
+
+    // External sampling. Devolve a utilidade do jogador atualizado a partir do nó N.
+    // Nos nós do oponente a média acumula a estratégia atual sem peso de
+    // alcance: o próprio sorteio já visita o nó com a probabilidade do oponente.
+    template <int N, int P>
+    double traverseExternal(const Deal& deal, double t) {
+        constexpr TreeNode node = TREE.nodes[N];
+        if constexpr (node.player < 0) {
+            return payoff(TREE.nodes[N], deal, P);
+        }
+        else {
+            constexpr int player = node.player;
+            constexpr auto actions = std::make_integer_sequence<int, node.numActions>();
+            const int infoSet = infoSetOf(node, deal, player);
+            double regret[NUM_ACTIONS];
+            double strategy[NUM_ACTIONS];
+            table.getRegrets(infoSet, node.numActions, regret);
+            currentStrategy(regret, node.numActions, strategy);
+            auto child = [&](auto id) { return traverseExternal<decltype(id)::value, P>(deal, t); };
+
+            if constexpr (player != P) {
+                const double weight = rule.averagingWeight(t);
+                double contribution[NUM_ACTIONS];
+                for (int a = 0; a < node.numActions; ++a) {
+                    contribution[a] = weight * strategy[a];
+                }
+                table.addStrategy(infoSet, node.numActions, contribution);
+                return withChild<N>(actions, sampleAction(strategy, node.numActions), child);
+            }
+
+            double actionUtils[NUM_ACTIONS];
+            double nodeUtility = 0.0;
+            for (int a = 0; a < node.numActions; ++a) {
+                actionUtils[a] = withChild<N>(actions, a, child);
+                nodeUtility += strategy[a] * actionUtils[a];
+            }
+            double advantages[NUM_ACTIONS];
+            for (int a = 0; a < node.numActions; ++a) {
+                advantages[a] = actionUtils[a] - nodeUtility;
+                regret[a] = rule.accumulateRegret(regret[a], advantages[a], t);
+            }
+            table.setRegrets(infoSet, node.numActions, regret);
+            if (dataset) {
+                recordSample<N>(infoSet, advantages);
+            }
+            return nodeUtility;
+        }
+    }
+
+    // Outcome sampling. Devolve a estimativa da utilidade do jogador
+    // atualizado, já dividida pela probabilidade de amostrar o caminho abaixo
+    // de N. myReach e oppReach são os alcances pela estratégia atual;
+    // sampleReach é a probabilidade de o sorteio ter chegado até N.
+    template <int N, int P>
+    double traverseOutcome(const Deal& deal, double myReach, double oppReach, double sampleReach, double t) {
+        constexpr TreeNode node = TREE.nodes[N];
+        if constexpr (node.player < 0) {
+            return payoff(TREE.nodes[N], deal, P);
+        }
+        else {
+            constexpr int player = node.player;
+            constexpr bool updating = player == P;
+            const int infoSet = infoSetOf(node, deal, player);
+            double regret[NUM_ACTIONS];
+            double strategy[NUM_ACTIONS];
+            double sampleProbs[NUM_ACTIONS];
+            table.getRegrets(infoSet, node.numActions, regret);
+            currentStrategy(regret, node.numActions, strategy);
+            for (int a = 0; a < node.numActions; ++a) {
+                sampleProbs[a] = updating
+                    ? OUTCOME_EXPLORATION / node.numActions + (1.0 - OUTCOME_EXPLORATION) * strategy[a]
+                    : strategy[a];
+            }
+
+            const int sampled = sampleAction(sampleProbs, node.numActions);
+            const double childMyReach = updating ? myReach * strategy[sampled] : myReach;
+            const double childOppReach = updating ? oppReach : oppReach * strategy[sampled];
+            const double childSampleReach = sampleReach * sampleProbs[sampled];
+            const double childValue = withChild<N>(
+                std::make_integer_sequence<int, node.numActions>(), sampled, [&](auto id) {
+                    return traverseOutcome<decltype(id)::value, P>(deal, childMyReach, childOppReach,
+                                                                   childSampleReach, t);
+                }) / sampleProbs[sampled];
+            // Só a ação sorteada tem valor estimado; as outras contam como zero.
+            const double nodeValue = strategy[sampled] * childValue;
+
+            if (updating) {
+                const double weight = rule.averagingWeight(t);
+                const double scale = oppReach / sampleReach;
+                double advantages[NUM_ACTIONS];
+                double contribution[NUM_ACTIONS];
+                for (int a = 0; a < node.numActions; ++a) {
+                    const double actionValue = a == sampled ? childValue : 0.0;
+                    advantages[a] = scale * (actionValue - nodeValue);
+                    regret[a] = rule.accumulateRegret(regret[a], advantages[a], t);
+                    contribution[a] = weight * myReach * strategy[a] / sampleReach;
+                }
+                table.setRegrets(infoSet, node.numActions, regret);
+                table.addStrategy(infoSet, node.numActions, contribution);
+                if (dataset) {
+                    recordSample<N>(infoSet, advantages);
+                }
+            }
+            return nodeValue;
+        }
+    }
+
+    // Valor do jogador 0 numa distribuição, seguindo as estratégias médias.
+    double expectedValue(int n, const Deal& deal) const {
+        const TreeNode& node = TREE.nodes[n];
+        if (node.player < 0) {
+            return payoff(node, deal, 0);
+        }
+        double strategy[NUM_ACTIONS];
+        averageStrategy(infoSetOf(node, deal, node.player), node.numActions, strategy);
+        double value = 0.0;
+        for (int a = 0; a < node.numActions; ++a) {
+            value += strategy[a] * expectedValue(node.children[a], deal);
+        }
+        return value;
+    }
+
+    // Melhor resposta sobre a árvore pública com um vetor por distribuição:
+    // reach[d] é a probabilidade de chance vezes o alcance dos oponentes, e o
+    // resultado é o valor do respondedor em cada distribuição já ponderado por
+    // reach. Nos nós do respondedor, cada infoset escolhe a ação que maximiza a
+    // soma sobre as distribuições que ele não distingue.
+    std::vector<double> bestResponse(int n, int responder, const std::vector<double>& reach) const {
+        const TreeNode& node = TREE.nodes[n];
+        std::vector<double> values(Game::NUM_DEALS, 0.0);
+        if (node.player < 0) {
+            for (int d = 0; d < Game::NUM_DEALS; ++d) {
+                if (reach[d] != 0.0) {
+                    values[d] = payoff(node, Game::deal(d), responder) * reach[d];
+                }
+            }
+            return values;
+        }
+
+        if (node.player != responder) {
+            std::vector<double> childReach(Game::NUM_DEALS);
+            double strategy[NUM_ACTIONS];
+            for (int a = 0; a < node.numActions; ++a) {
+                for (int d = 0; d < Game::NUM_DEALS; ++d) {
+                    averageStrategy(infoSetOf(node, Game::deal(d), node.player), node.numActions, strategy);
+                    childReach[d] = reach[d] * strategy[a];
+                }
+                std::vector<double> child = bestResponse(node.children[a], responder, childReach);
+                for (int d = 0; d < Game::NUM_DEALS; ++d) {
+                    values[d] += child[d];
+                }
+            }
+            return values;
+        }
+
+        std::vector<std::vector<double>> children;
+        for (int a = 0; a < node.numActions; ++a) {
+            children.push_back(bestResponse(node.children[a], responder, reach));
+        }
+        const int buckets = Game::BUCKETS[node.round];
+        std::vector<double> actionTotals(static_cast<size_t>(buckets) * NUM_ACTIONS, 0.0);
+        for (int d = 0; d < Game::NUM_DEALS; ++d) {
+            const int bucket = Game::bucket(Game::deal(d), responder, node.round);
+            for (int a = 0; a < node.numActions; ++a) {
+                actionTotals[bucket * NUM_ACTIONS + a] += children[a][d];
+            }
+        }
+        for (int d = 0; d < Game::NUM_DEALS; ++d) {
+            const int bucket = Game::bucket(Game::deal(d), responder, node.round);
+            int best = 0;
+            for (int a = 1; a < node.numActions; ++a) {
+                if (actionTotals[bucket * NUM_ACTIONS + a] > actionTotals[bucket * NUM_ACTIONS + best]) {
+                    best = a;
+                }
+            }
+            values[d] = children[best][d];
+        }
+        return values;
+    }
+};
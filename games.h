@@ -0,0 +1,292 @@
+#pragma once
+// Arquivo: games.h
+// Descritores de jogo em tempo de compilação para o GameSolver.
+//
+// Cada jogo é um tipo com constantes e funções constexpr: a árvore pública
+// de apostas (TREE) é construída pelo compilador a partir das regras de
+// apostas, e as distribuições de cartas, os "buckets" de informação privada
+// e a força das mãos são funções aritméticas simples. Nada disso existe em
+// tempo de execução além de tabelas constantes.
+//
+// Convenção das ações: sem aposta pendente, 0 = check e 1 = bet; diante de
+// uma aposta, 0 = fold, 1 = call e 2 = raise. Os jogos têm até
+// MAX_GAME_PLAYERS jogadores, que agem na ordem da mesa a partir do 0. No Kuhn isso coincide com o
+// PASS/BET do CFRTrainer, e os históricos usam as mesmas letras ("p"/"b",
+// mais "r" para raise e "/" para a troca de rodada).
+
+const int MAX_GAME_PLAYERS = 3;
+const int MAX_GAME_ACTIONS = 3;
+const int MAX_GAME_ROUNDS = 2;
+const int MAX_HISTORY_CHARS = 16;
+
+// Regras de um poker limit com ante.
+struct BettingRules {
+    int numPlayers;
+    int numRounds;
+    int ante;
+    int betSize[MAX_GAME_ROUNDS];
+    int maxBets;  // Apostas por rodada, contando o bet inicial e os raises
+};
+
+struct TreeNode {
+    int player;       // Jogador da vez, ou -1 em nós terminais
+    int round;
+    int numActions;
+    int children[MAX_GAME_ACTIONS];
+    int infoSetBase;  // Primeiro infoset do nó; soma-se o bucket do jogador
+    int contribution[MAX_GAME_PLAYERS];
+    int folded;       // Bit p ligado se o jogador p desistiu
+    int active;       // Jogadores que não desistiram; terminal com 1 ativo = fold, senão showdown
+    char history[MAX_HISTORY_CHARS];
+};
+
+template <int MaxNodes>
+struct GameTree {
+    TreeNode nodes[MaxNodes] = {};
+    int numNodes = 0;
+    int numInfoSets = 0;
+};
+
+// Constrói a árvore de apostas em pré-ordem (a raiz é o nó 0). Com mais de
+// dois jogadores a vez segue a mesa pulando quem desistiu, e a rodada fecha
+// quando todos os ativos agiram e igualaram a maior aposta.
+template <int MaxNodes>
+class TreeBuilder {
+public:
+    constexpr TreeBuilder(const BettingRules& rules, const int* bucketsPerRound) : rules(rules), buckets() {
+        for (int r = 0; r < rules.numRounds; ++r) {
+            buckets[r] = bucketsPerRound[r];
+        }
+    }
+
+    constexpr GameTree<MaxNodes> build() {
+        int contribution[MAX_GAME_PLAYERS] = {};
+        for (int p = 0; p < rules.numPlayers; ++p) {
+            contribution[p] = rules.ante;
+        }
+        char history[MAX_HISTORY_CHARS] = {};
+        addDecision(0, 0, 0, rules.numPlayers, contribution, 0, history, 0);
+        return tree;
+    }
+
+private:
+    BettingRules rules;
+    int buckets[MAX_GAME_ROUNDS];
+    GameTree<MaxNodes> tree;
+
+    constexpr int activeCount(int folded) const {
+        int count = 0;
+        for (int p = 0; p < rules.numPlayers; ++p) {
+            count += (folded >> p & 1) ? 0 : 1;
+        }
+        return count;
+    }
+
+    // Próximo jogador ativo depois de "player", na ordem da mesa.
+    constexpr int nextActive(int player, int folded) const {
+        int next = (player + 1) % rules.numPlayers;
+        while (folded >> next & 1) {
+            next = (next + 1) % rules.numPlayers;
+        }
+        return next;
+    }
+
+    constexpr int newNode(int player, int round, const int* contribution, int folded, const char* history,
+                          int length) {
+        int id = tree.numNodes++;
+        TreeNode& node = tree.nodes[id];
+        node.player = player;
+        node.round = round;
+        node.folded = folded;
+        node.active = activeCount(folded);
+        for (int p = 0; p < rules.numPlayers; ++p) {
+            node.contribution[p] = contribution[p];
+        }
+        for (int i = 0; i < length; ++i) {
+            node.history[i] = history[i];
+        }
+        return id;
+    }
+
+    // Fim da rodada sem fold: próxima rodada (o primeiro ativo abre) ou showdown.
+    constexpr int endRound(int round, const int* contribution, int folded, char* history, int length) {
+        if (round + 1 < rules.numRounds) {
+            history[length] = '/';
+            return addDecision(round + 1, nextActive(rules.numPlayers - 1, folded), 0, activeCount(folded),
+                               contribution, folded, history, length + 1);
+        }
+        return newNode(-1, round, contribution, folded, history, length);
+    }
+
+    // "pending" conta os jogadores ativos que ainda precisam agir na rodada,
+    // incluindo quem está na vez.
+    constexpr int afterAction(int round, int player, int bets, int pending, const int* contribution, int folded,
+                              char* history, int length) {
+        return pending == 0 ? endRound(round, contribution, folded, history, length)
+                            : addDecision(round, nextActive(player, folded), bets, pending, contribution, folded,
+                                          history, length);
+    }
+
+    constexpr int addDecision(int round, int player, int bets, int pending, const int* contribution, int folded,
+                              char* history, int length) {
+        int id = newNode(player, round, contribution, folded, history, length);
+        tree.nodes[id].infoSetBase = tree.numInfoSets;
+        tree.numInfoSets += buckets[round];
+
+        int highest = 0;
+        for (int p = 0; p < rules.numPlayers; ++p) {
+            highest = contribution[p] > highest ? contribution[p] : highest;
+        }
+        const int others = activeCount(folded) - 1;
+        int next[MAX_GAME_PLAYERS] = {};
+        for (int p = 0; p < rules.numPlayers; ++p) {
+            next[p] = contribution[p];
+        }
+        int numActions = 0;
+        int children[MAX_GAME_ACTIONS] = {};
+
+        if (contribution[player] == highest) {
+            history[length] = 'p'; // check
+            children[numActions++] =
+                afterAction(round, player, bets, pending - 1, next, folded, history, length + 1);
+            if (bets < rules.maxBets) {
+                history[length] = 'b'; // bet
+                next[player] = highest + rules.betSize[round];
+                children[numActions++] = afterAction(round, player, bets + 1, others, next, folded, history,
+                                                     length + 1);
+            }
+        }
+        else {
+            history[length] = 'p'; // fold
+            const int withFold = folded | (1 << player);
+            children[numActions++] = others == 1
+                ? newNode(-1, round, next, withFold, history, length + 1)
+                : afterAction(round, player, bets, pending - 1, next, withFold, history, length + 1);
+
+            history[length] = 'b'; // call
+            next[player] = highest;
+            children[numActions++] = afterAction(round, player, bets, pending - 1, next, folded, history,
+                                                 length + 1);
+
+            if (bets < rules.maxBets) {
+                history[length] = 'r'; // raise
+                next[player] = highest + rules.betSize[round];
+                children[numActions++] = afterAction(round, player, bets + 1, others, next, folded, history,
+                                                     length + 1);
+            }
+        }
+        history[length] = '\0';
+
+        tree.nodes[id].numActions = numActions;
+        for (int a = 0; a < numActions; ++a) {
+            tree.nodes[id].children[a] = children[a];
+        }
+        return id;
+    }
+};
+
+// Cartas de uma distribuição. board = -1 em jogos sem carta comunitária.
+struct Deal {
+    int cards[MAX_GAME_PLAYERS];
+    int board;
+};
+
+// Kuhn Poker generalizado: N cartas distintas, 1 rodada, aposta de 1 ficha.
+template <int N>
+struct KuhnGame {
+    static constexpr int NUM_PLAYERS = 2;
+    static constexpr int NUM_ACTIONS = 2;
+    static constexpr int NUM_CARDS = N;
+    static constexpr int NUM_DEALS = N * (N - 1);
+    static constexpr BettingRules RULES = { 2, 1, 1, { 1, 0 }, 1 };
+    static constexpr int BUCKETS[MAX_GAME_ROUNDS] = { N, 0 };
+    static constexpr GameTree<16> TREE = TreeBuilder<16>(RULES, BUCKETS).build();
+    static constexpr int NUM_INFOSETS = TREE.numInfoSets;
+
+    static constexpr Deal deal(int index) {
+        int first = index / (N - 1);
+        int second = index % (N - 1);
+        return Deal{ { first, second >= first ? second + 1 : second }, -1 };
+    }
+    static constexpr int bucket(const Deal& deal, int player, int) { return deal.cards[player]; }
+    static constexpr int strength(const Deal& deal, int player) { return deal.cards[player]; }
+    static const char* name() { return "Kuhn"; }
+};
+
+// Kuhn Poker de 3 jogadores: 4 cartas (J, Q, K, A), ante e aposta de 1
+// ficha e uma única aposta. Depois dela cada um dos outros paga ou desiste;
+// o pote vai para a maior carta entre quem pagou.
+struct Kuhn3PlayerGame {
+    static constexpr int NUM_PLAYERS = 3;
+    static constexpr int NUM_ACTIONS = 2;
+    static constexpr int NUM_CARDS = 4;
+    static constexpr int NUM_DEALS = 4 * 3 * 2;
+    static constexpr BettingRules RULES = { 3, 1, 1, { 1, 0 }, 1 };
+    static constexpr int BUCKETS[MAX_GAME_ROUNDS] = { NUM_CARDS, 0 };
+    static constexpr GameTree<64> TREE = TreeBuilder<64>(RULES, BUCKETS).build();
+    static constexpr int NUM_INFOSETS = TREE.numInfoSets;
+
+    // index = primeira * 6 + segunda * 2 + terceira, cada uma contada entre
+    // as cartas que sobraram.
+    static constexpr Deal deal(int index) {
+        int first = index / 6;
+        int second = index / 2 % 3;
+        int third = index % 2;
+        if (second >= first) {
+            ++second;
+        }
+        const int low = first < second ? first : second;
+        const int high = first < second ? second : first;
+        if (third >= low) {
+            ++third;
+        }
+        if (third >= high) {
+            ++third;
+        }
+        return Deal{ { first, second, third }, -1 };
+    }
+    static constexpr int bucket(const Deal& deal, int player, int) { return deal.cards[player]; }
+    static constexpr int strength(const Deal& deal, int player) { return deal.cards[player]; }
+    static const char* name() { return "Kuhn de 3 jogadores"; }
+};
+
+// Leduc Hold'em: 6 cartas (J, Q, K em dois naipes), 2 rodadas com uma carta
+// comunitária entre elas, apostas de 2 e 4 fichas e no máximo 2 apostas por
+// rodada. A carta k tem valor k / 2; só o valor importa para a informação.
+struct LeducGame {
+    static constexpr int NUM_PLAYERS = 2;
+    static constexpr int NUM_ACTIONS = 3;
+    static constexpr int NUM_CARDS = 6;
+    static constexpr int NUM_RANKS = 3;
+    static constexpr int NUM_DEALS = 6 * 5 * 4;
+    static constexpr BettingRules RULES = { 2, 2, 1, { 2, 4 }, 2 };
+    static constexpr int BUCKETS[MAX_GAME_ROUNDS] = { NUM_RANKS, NUM_RANKS * NUM_RANKS };
+    static constexpr GameTree<128> TREE = TreeBuilder<128>(RULES, BUCKETS).build();
+    static constexpr int NUM_INFOSETS = TREE.numInfoSets;
+
+    static constexpr Deal deal(int index) {
+        int first = index / 20;
+        int second = index / 4 % 5;
+        int board = index % 4;
+        if (second >= first) {
+            ++second;
+        }
+        int low = first < second ? first : second;
+        int high = first < second ? second : first;
+        if (board >= low) {
+            ++board;
+        }
+        if (board >= high) {
+            ++board;
+        }
+        return Deal{ { first, second }, board };
+    }
+    static constexpr int bucket(const Deal& deal, int player, int round) {
+        return round == 0 ? deal.cards[player] / 2 : deal.cards[player] / 2 * NUM_RANKS + deal.board / 2;
+    }
+    // Par com a mesa vence qualquer carta alta.
+    static constexpr int strength(const Deal& deal, int player) {
+        return deal.cards[player] / 2 == deal.board / 2 ? NUM_RANKS + deal.cards[player] / 2 : deal.cards[player] / 2;
+    }
+    static const char* name() { return "Leduc"; }
+};
@@ -0,0 +1,60 @@
+# Arquivo: kuhn_dataset.py
+# Lê os datasets .kds gravados pelo DatasetWriter do C++ (formato descrito em
+# dataset.h) sem copiar os registros: cada arquivo vira um numpy.memmap.
+#
+#   from kuhn_dataset import open_dataset
+#   for features, strategy, advantages in open_dataset("leduc"):
+#       ...
+
+import glob
+
+import numpy as np
+
+DATASET_MAGIC = b"KUHNDS\0\0"
+DATASET_VERSION = 1
+DATASET_HEADER_BYTES = 64
+
+HEADER_DTYPE = np.dtype([
+    ("magic", "S8"),
+    ("version", "<u4"),
+    ("num_features", "<u4"),
+    ("num_actions", "<u4"),
+    ("reserved", "<u4"),
+    ("num_records", "<u8"),
+    ("chunk", "<u8"),
+])
+
+
+def read_header(path):
+    header = np.fromfile(path, dtype=HEADER_DTYPE, count=1)[0]
+    if header["magic"] != DATASET_MAGIC.rstrip(b"\0") or header["version"] != DATASET_VERSION:
+        raise ValueError("%s nao e um dataset .kds suportado" % path)
+    return header
+
+
+def open_chunk(path):
+    """Devolve (features, strategy, advantages) como visões de um memmap."""
+    header = read_header(path)
+    features = int(header["num_features"])
+    actions = int(header["num_actions"])
+    records = int(header["num_records"])
+    if records == 0:
+        data = np.zeros((0, features + 2 * actions), dtype="<f4")
+    else:
+        data = np.memmap(path, dtype="<f4", mode="r", offset=DATASET_HEADER_BYTES,
+                         shape=(records, features + 2 * actions))
+    return data[:, :features], data[:, features:features + actions], data[:, features + actions:]
+
+
+def open_dataset(prefix):
+    """Lista de (features, strategy, advantages), um item por arquivo PREFIXO.NNNNN.kds."""
+    paths = sorted(glob.glob(glob.escape(prefix) + ".[0-9][0-9][0-9][0-9][0-9].kds"))
+    if not paths:
+        raise FileNotFoundError("nenhum arquivo %s.*.kds" % prefix)
+    return [open_chunk(path) for path in paths]
+
+
+def load_dataset(prefix):
+    """Concatena todos os arquivos na memória (para datasets que cabem nela)."""
+    chunks = open_dataset(prefix)
+    return tuple(np.concatenate([chunk[i] for chunk in chunks]) for i in range(3))
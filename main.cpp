@@ -1,11 +1,21 @@
 // Arquivo: main.cpp
 
+#include "alloc_counter.h"
 #include "cfr_poker.h"
+#include "game_solver.h"
+#include "match_simulator.h"
+#include "mlp.h"
+#include "strategy_file.h"
+#include "subgame_resolver.h"
 #include <iostream>
-#include <string> // Necessrio para std::string
+#include <string> // Necessário para std::string
+#include <cstring>
+#include <chrono>
+#include <memory>
+#include <random>
 
-// --- FUNO AUXILIAR NOVA ---
-// Traduz o ID numrico da carta para um nome legvel.
+// --- FUNÇÃO AUXILIAR NOVA ---
+// Traduz o ID numérico da carta para um nome legível.
 std::string getCardName(int cardValue) {
     switch (cardValue) {
     case 0: return "Valete (J)";
@@ -15,31 +25,712 @@ std::string getCardName(int cardValue) {
     }
 }
 
-int main() {
-    // Para um teste rpido, 10 milhes de iteraes  timo.
+// Lê um inteiro positivo de "text" inteiro; senão, explica o erro de "flag" e retorna false.
+bool parsePositive(const char* flag, const char* text, int& value) {
+    char* end = nullptr;
+    const long parsed = std::strtol(text, &end, 10);
+    if (end == text || *end != '\0' || parsed <= 0 || parsed > 1000000) {
+        std::cerr << flag << " espera um inteiro positivo: " << text << std::endl;
+        return false;
+    }
+    value = static_cast<int>(parsed);
+    return true;
+}
+
+// Mostra quantos registros o dataset recebeu e quantos a fila descartou.
+void reportDataset(const DatasetWriter& dataset, const std::string& prefix) {
+    std::cout << "Dataset salvo em " << prefix << ".*.kds (" << dataset.seen() << " registros gerados, "
+              << dataset.dropped() << " descartados com a fila cheia)" << std::endl;
+}
+
+// Treina um jogo do games.h com o núcleo genérico, mostrando a exploitability
+// a cada 10% das iterações. Com datasetPrefix, grava o dataset da travessia.
+template <class Game>
+bool solveGame(int iterations, uint64_t seed, Sampling sampling, const std::string& datasetPrefix,
+               int datasetEvery, const DatasetOptions& datasetOptions) {
+    GameSolver<Game> solver(seed, CFRPlus(), sampling);
+    DatasetWriter dataset;
+    if (!datasetPrefix.empty()) {
+        if (!dataset.open(datasetPrefix, GameSolver<Game>::NUM_FEATURES, Game::NUM_ACTIONS, datasetOptions)) {
+            return false;
+        }
+        solver.setDataset(&dataset, datasetEvery);
+    }
+    std::cout << Game::name() << ": " << Game::NUM_INFOSETS << " infosets, " << Game::TREE.numNodes
+              << " nos na arvore de apostas." << std::endl;
+    auto start = std::chrono::steady_clock::now();
+    const int step = iterations >= 10 ? iterations / 10 : iterations;
+    for (int done = 0; done < iterations; done += step) {
+        solver.train(done + step <= iterations ? step : iterations - done);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "Iteracao: " << solver.getIterations() << ", Exploitability: " << solver.exploitability()
+                  << " mbb/mao, " << elapsed.count() << " s" << std::endl;
+    }
+    std::cout << "Valor do jogo para o jogador 0: " << solver.gameValue() << " fichas/mao" << std::endl;
+    if (dataset.isOpen()) {
+        dataset.close();
+        reportDataset(dataset, datasetPrefix);
+    }
+    return true;
+}
+
+const char* const SAMPLING_NAMES[] = { "chance", "external", "outcome" };
+
+// Exploitability por tempo de parede de um modo de amostragem, em CSV. O
+// relógio só corre durante o treino: as melhores respostas ficam de fora.
+template <class Solver, class Train, class Exploitability>
+void benchmarkConvergence(const char* game, const char* method, double seconds, Solver& solver, Train train,
+                          Exploitability exploitability) {
+    const double checkpoints[] = { 0.01, 0.03, 0.1, 0.3, 1.0, 3.0, 10.0, 30.0 };
+    const int chunk = 256;
+    double elapsed = 0.0;
+    long long done = 0;
+    for (double checkpoint : checkpoints) {
+        if (checkpoint > seconds) {
+            break;
+        }
+        while (elapsed < checkpoint) {
+            auto start = std::chrono::steady_clock::now();
+            train(solver, chunk);
+            elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            done += chunk;
+        }
+        std::cout << game << "," << method << "," << checkpoint << "," << done << "," << exploitability(solver)
+                  << std::endl;
+    }
+}
+
+template <class Game>
+void benchmarkSampling(const char* game, double seconds, uint64_t seed) {
+    for (int mode = CHANCE_SAMPLING; mode <= OUTCOME_SAMPLING; ++mode) {
+        // Na pilha só cabem as tabelas dos jogos pequenos.
+        std::unique_ptr<GameSolver<Game>> solver(new GameSolver<Game>(seed, CFRPlus(), static_cast<Sampling>(mode)));
+        benchmarkConvergence(
+            game, SAMPLING_NAMES[mode], seconds, *solver, [](GameSolver<Game>& s, int n) { s.train(n); },
+            [](const GameSolver<Game>& s) { return s.exploitability(); });
+    }
+}
+
+// Compara, por segundo de treino, o train() do CFRTrainer (mt19937 +
+// std::shuffle) com os três modos do GameSolver no Kuhn e no Leduc.
+void benchmarkMCCFR(double seconds, uint64_t seed) {
+    std::cout << "jogo,metodo,segundos,iteracoes,exploitability_mbb" << std::endl;
+    CFRTrainer trainer(static_cast<unsigned int>(seed));
+    trainer.setVerbose(false);
+    benchmarkConvergence(
+        "kuhn3", "trainer", seconds, trainer, [](CFRTrainer& t, int n) { t.train(n); },
+        [](CFRTrainer& t) { return t.exploitability(); });
+    benchmarkSampling<KuhnGame<3>>("kuhn3", seconds, seed);
+    benchmarkSampling<LeducGame>("leduc", seconds, seed);
+}
+
+// Treina o mesmo jogo com a mesma semente em um formato de tabela e mostra a
+// exploitability final ao lado da obtida em double.
+template <class Game, class Rule, class Table>
+void benchmarkTable(const char* game, const char* ruleName, const Rule& rule, const char* table, int iterations,
+                    uint64_t seed, double reference) {
+    std::unique_ptr<GameSolver<Game, Rule, Table>> solver(new GameSolver<Game, Rule, Table>(seed, rule));
+    auto start = std::chrono::steady_clock::now();
+    solver->train(iterations);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    const double exploitability = solver->exploitability();
+    std::cout << game << "," << ruleName << "," << table << "," << solver->bytesPerInfoSet() << ","
+              << iterations / elapsed.count() << "," << exploitability << "," << exploitability - reference
+              << std::endl;
+}
+
+template <class Game, class Rule>
+void benchmarkTables(const char* game, const char* ruleName, const Rule& rule, int iterations, uint64_t seed) {
+    std::unique_ptr<GameSolver<Game, Rule>> reference(new GameSolver<Game, Rule>(seed, rule));
+    reference->train(iterations);
+    const double base = reference->exploitability();
+    benchmarkTable<Game, Rule, PlainTable<double>>(game, ruleName, rule, "double", iterations, seed, base);
+    benchmarkTable<Game, Rule, PlainTable<float>>(game, ruleName, rule, "float", iterations, seed, base);
+    benchmarkTable<Game, Rule, QuantizedTable<int32_t>>(game, ruleName, rule, "int32", iterations, seed, base);
+    benchmarkTable<Game, Rule, QuantizedTable<int16_t>>(game, ruleName, rule, "int16", iterations, seed, base);
+}
+
+// Quanto de exploitability se perde em cada formato de tabela (regret_storage.h).
+void benchmarkPrecision(int iterations, uint64_t seed) {
+    std::cout << "jogo,regra,tabela,bytes_por_infoset,iteracoes_por_s,exploitability_mbb,diferenca_mbb" << std::endl;
+    const DiscountedCFR dcfr{ 1.5, 0.0, 2.0 };
+    benchmarkTables<KuhnGame<13>>("kuhn13", "cfr+", CFRPlus(), iterations, seed);
+    benchmarkTables<LeducGame>("leduc", "cfr+", CFRPlus(), iterations, seed);
+    benchmarkTables<LeducGame>("leduc", "dcfr", dcfr, iterations, seed);
+}
+
+// Latência de uma decisão e vazão em lote da rede .kmlp.
+int benchmarkMLP(const std::string& path) {
+    MLPModel model;
+    if (!model.load(path)) {
+        return 1;
+    }
+    if (model.inputSize() != NUM_FEATURES) {
+        std::cerr << "A rede espera " << model.inputSize() << " entradas; o Kuhn Poker usa " << NUM_FEATURES << "."
+                  << std::endl;
+        return 1;
+    }
+    // Lote com os 12 infosets repetidos.
+    const int batch = NUM_INFOSETS * 1024;
+    std::vector<float> inputs(static_cast<size_t>(batch) * NUM_FEATURES);
+    std::vector<float> outputs(static_cast<size_t>(batch) * model.outputSize());
+    double features[NUM_FEATURES];
+    for (int row = 0; row < batch; ++row) {
+        const int infoSet = row % NUM_INFOSETS;
+        InfoSetTable::features(infoSet % NUM_CARDS, infoSet / NUM_CARDS, features);
+        for (int f = 0; f < NUM_FEATURES; ++f) {
+            inputs[static_cast<size_t>(row) * NUM_FEATURES + f] = static_cast<float>(features[f]);
+        }
+    }
+
+    const int decisions = 1000000;
+    float checksum = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < decisions; ++i) {
+        model.forward(&inputs[static_cast<size_t>(i % NUM_INFOSETS) * NUM_FEATURES], outputs.data());
+        checksum += outputs[0];
+    }
+    std::chrono::duration<double, std::nano> single = std::chrono::steady_clock::now() - start;
+
+    const int rounds = 100;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; ++i) {
+        model.forwardBatch(inputs.data(), batch, outputs.data());
+        checksum += outputs[0];
+    }
+    std::chrono::duration<double> batched = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Latencia por decisao: " << single.count() / decisions << " ns" << std::endl;
+    std::cout << "Vazao em lote: " << static_cast<double>(batch) * rounds / batched.count() << " estados/s"
+              << " (checksum " << checksum << ")" << std::endl;
+    return 0;
+}
+
+// Resolve o subjogo a partir de "history" com alcances uniformes, mostra a
+// estratégia de quem age e mede a vazão do pool com um lote de pedidos iguais.
+int resolveSubgame(const std::string& history, int iterations, double budgetMs, int numThreads,
+                   const KuhnRules& rules) {
+    SubgameQuery query;
+    query.root = InfoSetTable::packHistory(history);
+    if (InfoSetTable::historyIndex(query.root) < 0) {
+        std::cerr << "Historico sem decisao: \"" << history << "\"" << std::endl;
+        return 1;
+    }
+    for (int p = 0; p < NUM_PLAYERS; ++p) {
+        for (int c = 0; c < NUM_CARDS; ++c) {
+            query.ranges[p][c] = 1.0;
+        }
+    }
+    query.maxIterations = iterations;
+    query.maxSeconds = budgetMs / 1000.0;
+
+    SubgameResolver resolver(numThreads, rules);
+    SubgameSolution solution;
+    resolver.resolve(query, solution);
+    std::cout << "Subjogo \"" << history << "\": " << solution.iterations << " iteracoes em "
+              << solution.seconds * 1e6 << " us" << std::endl;
+    for (int c = 0; c < NUM_CARDS; ++c) {
+        std::cout << "  " << getCardName(c) << ": PASS " << solution.strategy[c][PASS] * 100 << "%, BET "
+                  << solution.strategy[c][BET] * 100 << "%" << std::endl;
+    }
+
+    const int batch = 10000;
+    std::vector<SubgameQuery> queries(batch, query);
+    std::vector<SubgameSolution> solutions(batch);
+    long long allocationsBefore = alloc_counter::count();
+    auto start = std::chrono::steady_clock::now();
+    resolver.resolveBatch(queries.data(), solutions.data(), batch);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Vazao: " << batch / elapsed.count() << " subjogos/s em " << resolver.numThreads() << " threads"
+              << std::endl;
+    if (alloc_counter::enabled()) {
+        std::cout << "Alocacoes no heap durante o lote: " << alloc_counter::count() - allocationsBefore << std::endl;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // Para um teste rápido, 10 milhões de iterações é ótimo.
     int iterations = 10000000;
 
-    CFRTrainer trainer;
-    trainer.train(iterations);
+    // Opções de linha de comando:
+    //   --vectorized      CFR+ com todas as distribuições por iteração (100 mil iterações por padrão)
+    //   --iterations N    Limite de iterações
+    //   --check N         Mede a exploitability a cada N iterações
+    //   --target MBB      Para assim que a exploitability ficar abaixo de MBB mbb/mão
+    //   --seed S          Semente fixa do RNG (treinamento reprodutível)
+    //   --threads N       Treinamento amostrado em N threads, com somas atômicas na tabela;
+    //                     --shards troca para o modo reprodutível (a mesma --seed dá o mesmo
+    //                     resultado), que converge mais devagar por iteração; --sync K
+    //                     distribuições por rodada (padrão 256; menor converge mais perto do
+    //                     treino serial e sincroniza mais)
+    //   --scaling         Mede iterações/s com 1, 2, 4, 8 e 16 threads e sai
+    //   --rule R          Regra de atualização: cfr, cfr+ (padrão), linear ou dcfr
+    //                     (--alpha, --beta, --gamma para o DCFR; --simultaneous desliga a alternância)
+    //   --compare-rules   Relatório de convergência de todas as regras no modo vetorizado e sai
+    //   --resume ARQ      Retoma o treinamento de um checkpoint binário
+    //   --ante A, --bet B Payoffs da variante do Kuhn (padrão: 1 e 1)
+    //   --warm-start ARQ  Parte de uma solução anterior: um checkpoint .kcfr (tabelas
+    //                     multiplicadas por --warm-regret D e --warm-average D) ou uma
+    //                     estratégia "gto", .csv ou .kmlp (vale --warm-iterations N)
+    //   --save ARQ        Salva o checkpoint ao final (e a cada --checkpoint-every N iterações)
+    //   --csv ARQ         Dataset para o train_nn.py (padrão: kuhn_poker_gto.csv)
+    //   --telemetry ARQ   Telemetria JSONL do train() (requer KUHN_TELEMETRY; --telemetry-every N)
+    //   --dataset PREFIXO Dataset binário para redes (dataset.h, kuhn_dataset.py) em PREFIXO.*.kds;
+    //                     um registro a cada --dataset-every K atualizações, no máximo
+    //                     --dataset-max N registros (reservatório). Vale para --game e,
+    //                     no Kuhn, força o trainParallel() (1 thread se --threads faltar;
+    //                     não combina com --vectorized)
+    //   --inspect ARQ     Mapeia um checkpoint, mostra a estratégia e sai
+    //   --resolve HIST    Resolve o subjogo a partir do histórico ("" a "pb") com alcances
+    //                     uniformes, em até --iterations (padrão 1000) e --budget-ms MS, e sai;
+    //                     --threads dimensiona o pool
+    //   --game JOGO       Resolve kuhn3, kuhn5, kuhn13, kuhn3p (3 jogadores) ou leduc com o
+    //                     núcleo genérico e sai
+    //                     (--sampling chance, external ou outcome)
+    //   --mccfr-bench S   Exploitability por tempo de treino dos modos de amostragem,
+    //                     até S segundos por modo, em CSV, e sai
+    //   --precision-bench Exploitability com tabelas em double, float, int32 e int16
+    //                     após --iterations (padrão 1 milhão), em CSV, e sai
+    //   --mlp-bench ARQ   Latência e vazão da rede .kmlp exportada pelo train_nn.py e sai
+    //   --match A B       Confronto entre duas políticas ("gto", .kcfr, .csv ou .kmlp) e sai;
+    //                     usa --hands N, --threads, --seed e --duplicate
+    //   --no-pause        Não espera o Enter no final (só o Windows espera, para o
+    //                     console aberto com dois cliques não sumir)
+    std::string resumePath;
+    std::string warmStartPath;
+    WarmStartOptions warmStart;
+    KuhnRules kuhnRules;
+    std::string savePath;
+    std::string csvPath = "kuhn_poker_gto.csv";
+    std::string inspectPath;
+    std::string resolveHistory;
+    bool resolving = false;
+    double budgetMs = 0.0;
+    std::string game;
+    std::string telemetryPath;
+    std::string mlpBenchPath;
+    std::string datasetPrefix;
+    int datasetEvery = 1;
+    DatasetOptions datasetOptions;
+    Sampling sampling = CHANCE_SAMPLING;
+    double mccfrBenchSeconds = 0.0;
+    bool precisionBench = false;
+#ifdef _WIN32
+    bool pauseAtExit = true;
+#else
+    bool pauseAtExit = false;
+#endif
+    int telemetryEvery = 100000;
+    int checkpointEvery = 0;
+    std::string matchA;
+    std::string matchB;
+    MatchOptions match;
+    bool vectorized = false;
+    bool customIterations = false;
+    bool scaling = false;
+    bool seeded = false;
+    bool compareRules = false;
+    UpdateRule rule;
+    ConvergenceOptions convergence;
+    ParallelOptions parallel;
+    parallel.numThreads = 0;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--vectorized") == 0) {
+            vectorized = true;
+        }
+        else if (std::strcmp(argv[i], "--iterations") == 0 && hasValue) {
+            iterations = std::atoi(argv[++i]);
+            customIterations = true;
+        }
+        else if (std::strcmp(argv[i], "--check") == 0 && hasValue) {
+            convergence.checkInterval = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--target") == 0 && hasValue) {
+            convergence.targetMbb = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+            parallel.numThreads = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+            parallel.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+            seeded = true;
+        }
+        else if (std::strcmp(argv[i], "--sync") == 0 && hasValue) {
+            parallel.syncInterval = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--atomic") == 0) {
+            parallel.atomicUpdates = true;
+        }
+        else if (std::strcmp(argv[i], "--shards") == 0) {
+            parallel.atomicUpdates = false;
+        }
+        else if (std::strcmp(argv[i], "--scaling") == 0) {
+            scaling = true;
+        }
+        else if (std::strcmp(argv[i], "--rule") == 0 && hasValue) {
+            if (!UpdateRule::parse(argv[++i], rule)) {
+                std::cerr << "Regra desconhecida: " << argv[i] << std::endl;
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--simultaneous") == 0) {
+            rule.alternating = false;
+        }
+        else if (std::strcmp(argv[i], "--alpha") == 0 && hasValue) {
+            rule.alpha = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--beta") == 0 && hasValue) {
+            rule.beta = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--gamma") == 0 && hasValue) {
+            rule.gamma = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--compare-rules") == 0) {
+            compareRules = true;
+        }
+        else if (std::strcmp(argv[i], "--resume") == 0 && hasValue) {
+            resumePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--ante") == 0 && hasValue) {
+            if (!parsePositive("--ante", argv[++i], kuhnRules.ante)) {
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--bet") == 0 && hasValue) {
+            if (!parsePositive("--bet", argv[++i], kuhnRules.betSize)) {
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--warm-start") == 0 && hasValue) {
+            warmStartPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--warm-regret") == 0 && hasValue) {
+            warmStart.regretDiscount = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--warm-average") == 0 && hasValue) {
+            warmStart.strategyDiscount = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--warm-iterations") == 0 && hasValue) {
+            warmStart.strategyIterations = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--save") == 0 && hasValue) {
+            savePath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--checkpoint-every") == 0 && hasValue) {
+            checkpointEvery = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--csv") == 0 && hasValue) {
+            csvPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--resolve") == 0 && hasValue) {
+            resolveHistory = argv[++i];
+            resolving = true;
+        }
+        else if (std::strcmp(argv[i], "--budget-ms") == 0 && hasValue) {
+            budgetMs = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--inspect") == 0 && hasValue) {
+            inspectPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--match") == 0 && i + 2 < argc) {
+            matchA = argv[++i];
+            matchB = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--telemetry") == 0 && hasValue) {
+            telemetryPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--telemetry-every") == 0 && hasValue) {
+            telemetryEvery = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--dataset") == 0 && hasValue) {
+            datasetPrefix = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--dataset-every") == 0 && hasValue) {
+            datasetEvery = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--dataset-max") == 0 && hasValue) {
+            datasetOptions.maxRecords = std::atoll(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--mlp-bench") == 0 && hasValue) {
+            mlpBenchPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--game") == 0 && hasValue) {
+            game = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--sampling") == 0 && hasValue) {
+            const char* name = argv[++i];
+            int mode = CHANCE_SAMPLING;
+            while (mode <= OUTCOME_SAMPLING && std::strcmp(name, SAMPLING_NAMES[mode]) != 0) {
+                ++mode;
+            }
+            if (mode > OUTCOME_SAMPLING) {
+                std::cerr << "Amostragem desconhecida: " << name << std::endl;
+                return 1;
+            }
+            sampling = static_cast<Sampling>(mode);
+        }
+        else if (std::strcmp(argv[i], "--mccfr-bench") == 0 && hasValue) {
+            mccfrBenchSeconds = std::atof(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--precision-bench") == 0) {
+            precisionBench = true;
+        }
+        else if (std::strcmp(argv[i], "--no-pause") == 0) {
+            pauseAtExit = false;
+        }
+        else if (std::strcmp(argv[i], "--hands") == 0 && hasValue) {
+            match.hands = std::atoll(argv[++i]);
+        }
+        else if (std::strcmp(argv[i], "--duplicate") == 0) {
+            match.duplicate = true;
+        }
+    }
+
+    if (!mlpBenchPath.empty()) {
+        return benchmarkMLP(mlpBenchPath);
+    }
+
+    if (mccfrBenchSeconds > 0) {
+        benchmarkMCCFR(mccfrBenchSeconds, seeded ? parallel.seed : std::random_device()());
+        return 0;
+    }
+
+    if (precisionBench) {
+        benchmarkPrecision(customIterations ? iterations : 1000000, seeded ? parallel.seed : std::random_device()());
+        return 0;
+    }
+
+    if (!game.empty()) {
+        const int gameIterations = customIterations ? iterations : 1000000;
+        const uint64_t gameSeed = seeded ? parallel.seed : std::random_device()();
+        datasetOptions.seed = gameSeed;
+        bool solved = false;
+        if (game == "kuhn3") {
+            solved = solveGame<KuhnGame<3>>(gameIterations, gameSeed, sampling, datasetPrefix, datasetEvery,
+                                            datasetOptions);
+        }
+        else if (game == "kuhn5") {
+            solved = solveGame<KuhnGame<5>>(gameIterations, gameSeed, sampling, datasetPrefix, datasetEvery,
+                                            datasetOptions);
+        }
+        else if (game == "kuhn13") {
+            solved = solveGame<KuhnGame<13>>(gameIterations, gameSeed, sampling, datasetPrefix, datasetEvery,
+                                             datasetOptions);
+        }
+        else if (game == "kuhn3p") {
+            solved = solveGame<Kuhn3PlayerGame>(gameIterations, gameSeed, sampling, datasetPrefix, datasetEvery,
+                                                datasetOptions);
+        }
+        else if (game == "leduc") {
+            solved = solveGame<LeducGame>(gameIterations, gameSeed, sampling, datasetPrefix, datasetEvery,
+                                          datasetOptions);
+        }
+        else {
+            std::cerr << "Jogo desconhecido: " << game << std::endl;
+        }
+        return solved ? 0 : 1;
+    }
+
+    if (!matchA.empty()) {
+        Policy a, b;
+        if (!Policy::load(matchA, a) || !Policy::load(matchB, b)) {
+            return 1;
+        }
+        match.numThreads = parallel.numThreads > 0 ? parallel.numThreads : 1;
+        match.seed = parallel.seed;
+
+        std::cout << "Confronto: " << a.name << " vs " << b.name << " (" << match.hands << " maos, "
+                  << match.numThreads << " threads" << (match.duplicate ? ", duplicado" : "") << ")" << std::endl;
+        MatchResult result = simulateMatch(a, b, match);
+        std::cout << "Winrate de " << a.name << ": " << result.mean * 1000 << " mbb/mao (IC 95%: ["
+                  << result.ciLow * 1000 << ", " << result.ciHigh * 1000 << "])" << std::endl;
+        std::cout << "Valor esperado exato: " << expectedValue(a, b) * 1000 << " mbb/mao" << std::endl;
+        std::cout << "Maos por segundo: " << result.handsPerSecond << std::endl;
+        return 0;
+    }
+
+    if (resolving) {
+        return resolveSubgame(resolveHistory, customIterations ? iterations : 1000, budgetMs,
+                              parallel.numThreads > 0 ? parallel.numThreads : 1, kuhnRules);
+    }
+
+    if (!inspectPath.empty()) {
+        auto openStart = std::chrono::steady_clock::now();
+        StrategyFile file;
+        bool opened = file.open(inspectPath);
+        std::chrono::duration<double, std::micro> openTime = std::chrono::steady_clock::now() - openStart;
+        if (!opened) {
+            return 1;
+        }
+        std::cout << "Checkpoint com " << file.iterations() << " iteracoes, mapeado em "
+                  << openTime.count() << " us." << std::endl;
+        for (int infoSet = 0; infoSet < file.numInfoSets(); ++infoSet) {
+            const double* s = file.strategy(infoSet);
+            std::cout << "  " << InfoSetTable::name(infoSet) << ": PASS " << s[PASS] * 100
+                      << "%, BET " << s[BET] * 100 << "%" << std::endl;
+        }
+        return 0;
+    }
+
+    if (compareRules) {
+        // Cada regra roda no modo vetorizado (determinístico) até a meta ou o limite de iterações.
+        const UpdateRule::Kind kinds[] = { UpdateRule::VANILLA, UpdateRule::CFR_PLUS, UpdateRule::LINEAR,
+                                           UpdateRule::DISCOUNTED };
+        ConvergenceOptions compare;
+        compare.checkInterval = convergence.checkInterval > 0 ? convergence.checkInterval : 10;
+        compare.targetMbb = convergence.targetMbb > 0 ? convergence.targetMbb : 0.1;
+        int limit = customIterations ? iterations : 100000;
+
+        std::cout << "regra,alternado,iteracoes,segundos,exploitability_mbb" << std::endl;
+        for (UpdateRule::Kind kind : kinds) {
+            for (int alternating = 1; alternating >= 0; --alternating) {
+                UpdateRule candidate = rule;
+                candidate.kind = kind;
+                candidate.alternating = alternating != 0;
+                CFRTrainer compareTrainer(0);
+                compareTrainer.setUpdateRule(candidate);
+                std::streambuf* silenced = std::cout.rdbuf(nullptr);
+                auto compareStart = std::chrono::steady_clock::now();
+                int done = compareTrainer.trainVectorized(limit, compare);
+                std::chrono::duration<double> compareElapsed = std::chrono::steady_clock::now() - compareStart;
+                std::cout.rdbuf(silenced);
+                // Se o limite não cai em uma medição (ou fica abaixo da primeira), mede o ponto final aqui.
+                const std::vector<ConvergencePoint>& points = compareTrainer.getConvergence();
+                ConvergencePoint last{ done, compareElapsed.count(), 0.0 };
+                if (!points.empty() && points.back().iteration == done) {
+                    last = points.back();
+                }
+                else {
+                    last.exploitabilityMbb = compareTrainer.exploitability();
+                }
+                std::cout << candidate.name() << "," << alternating << "," << done << "," << last.seconds << ","
+                          << last.exploitabilityMbb << std::endl;
+            }
+        }
+        return 0;
+    }
+
+    if (scaling) {
+        const int threadCounts[] = { 1, 2, 4, 8, 16 };
+        std::cout << "threads,iteracoes_por_segundo" << std::endl;
+        for (int threads : threadCounts) {
+            CFRTrainer scalingTrainer;
+            parallel.numThreads = threads;
+            auto scalingStart = std::chrono::steady_clock::now();
+            int done = scalingTrainer.trainParallel(iterations, parallel);
+            std::chrono::duration<double> scalingElapsed = std::chrono::steady_clock::now() - scalingStart;
+            std::cout << threads << "," << done / scalingElapsed.count() << std::endl;
+        }
+        return 0;
+    }
+    if (vectorized && !customIterations) {
+        iterations = 100000;
+    }
+    if (convergence.targetMbb > 0 && convergence.checkInterval == 0) {
+        convergence.checkInterval = vectorized ? 100 : 100000;
+    }
+
+    CFRTrainer trainer = seeded ? CFRTrainer(parallel.seed) : CFRTrainer();
+    if (!seeded) {
+        // Sem --seed, o trainParallel() e o reservatório do dataset também sorteiam a semente.
+        parallel.seed = std::random_device()();
+    }
+    trainer.setUpdateRule(rule);
+    trainer.setRules(kuhnRules);
+    if (!resumePath.empty()) {
+        if (!trainer.loadCheckpoint(resumePath)) {
+            return 1;
+        }
+        std::cout << "Retomando de " << resumePath << " (" << trainer.getIterations() << " iteracoes)." << std::endl;
+    }
+    if (!warmStartPath.empty()) {
+        auto hasSuffix = [&warmStartPath](const char* suffix) {
+            const size_t length = std::strlen(suffix);
+            return warmStartPath.size() > length &&
+                   warmStartPath.compare(warmStartPath.size() - length, length, suffix) == 0;
+        };
+        if (warmStartPath == "gto" || hasSuffix(".csv") || hasSuffix(".kmlp")) {
+            Policy policy;
+            if (!Policy::load(warmStartPath, policy)) {
+                return 1;
+            }
+            trainer.warmStart(policy.strategy, warmStart);
+        }
+        else if (!trainer.warmStart(warmStartPath, warmStart)) {
+            return 1;
+        }
+        std::cout << "Warm start de " << warmStartPath << " (ante " << kuhnRules.ante << ", aposta "
+                  << kuhnRules.betSize << "): exploitability inicial " << trainer.exploitability() << " mbb/mao."
+                  << std::endl;
+    }
+    if (!savePath.empty() && checkpointEvery > 0) {
+        trainer.enableCheckpoints(savePath, checkpointEvery);
+    }
+    if (!telemetryPath.empty() && !trainer.enableTelemetry(telemetryPath, telemetryEvery)) {
+        return 1;
+    }
+    if (!datasetPrefix.empty()) {
+        // Só as travessias do trainParallel() gravam o dataset; o vetorizado não tem amostras.
+        if (vectorized) {
+            std::cerr << "--dataset nao funciona com --vectorized (use --threads N)." << std::endl;
+            return 1;
+        }
+        datasetOptions.seed = parallel.seed;
+        if (!trainer.enableDataset(datasetPrefix, datasetEvery, datasetOptions)) {
+            return 1;
+        }
+        if (parallel.numThreads <= 0) {
+            parallel.numThreads = 1;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (vectorized) {
+        trainer.trainVectorized(iterations, convergence);
+    }
+    else if (parallel.numThreads > 0) {
+        trainer.trainParallel(iterations, parallel, convergence);
+    }
+    else {
+        trainer.train(iterations, convergence);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Tempo de treinamento: " << elapsed.count() << " s" << std::endl;
+    std::cout << "Exploitability final: " << trainer.exploitability() << " mbb/mao" << std::endl;
+    if (trainer.getDataset()) {
+        trainer.getDataset()->close();
+        reportDataset(*trainer.getDataset(), datasetPrefix);
+    }
+
+    if (!savePath.empty() && trainer.saveCheckpoint(savePath)) {
+        std::cout << "Checkpoint salvo em " << savePath << std::endl;
+    }
+    if (trainer.exportCSV(csvPath)) {
+        std::cout << "Dataset GTO salvo em " << csvPath << std::endl;
+    }
 
     std::cout << "\n--- ESTRATEGIAS FINAIS ---" << std::endl;
 
     // --- CHAMADAS ATUALIZADAS ---
-    // Estratgia com a pior mo
+    // Estratégia com a pior mão
     std::cout << "\nEstrategia com um " << getCardName(0) << " (no 0/):" << std::endl;
     trainer.printStrategy("0/");
 
-    // Estratgia com a mo mdia
+    // Estratégia com a mão média
     std::cout << "\nEstrategia com uma " << getCardName(1) << " (no 1/):" << std::endl;
     trainer.printStrategy("1/");
 
-    // Estratgia com a melhor mo
+    // Estratégia com a melhor mão
     std::cout << "\nEstrategia com um " << getCardName(2) << " (no 2/):" << std::endl;
     trainer.printStrategy("2/");
 
-    std::cout << "\nPressione Enter para sair." << std::endl;
-    std::cin.get();
+    if (pauseAtExit) {
+        std::cout << "\nPressione Enter para sair." << std::endl;
+        std::cin.get();
+    }
 
     return 0;
 }
-// --- FIM DO CDIGO ---
\ No newline at end of file
+// --- FIM DO CÓDIGO ---
\ No newline at end of file
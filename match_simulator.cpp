@@ -0,0 +1,291 @@
+// Arquivo: match_simulator.cpp
+
+#include "match_simulator.h"
+#include "mlp.h"
+#include "rng.h"
+#include "strategy_file.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Payoff do jogador 0 em um histórico terminal.
+inline int terminalPayoff(const HistoryInfo& info, const int* cards) {
+    if (info.showdown != 0) {
+        return cards[0] > cards[1] ? info.showdown : -info.showdown;
+    }
+    return info.foldPayoff;
+}
+
+// Joga uma mão completa; seats[p] é a política sentada na posição p.
+inline int playHand(const Policy* const* seats, const int* cards, Xoshiro256& rng) {
+    History history = ROOT_HISTORY;
+    for (;;) {
+        const HistoryInfo& info = HISTORY_INFO[history];
+        if (info.row < 0) {
+            return terminalPayoff(info, cards);
+        }
+        const double* s = seats[info.player]->at(cards[info.player], info.row);
+        history = nextHistory(history, rng.nextDouble() < s[PASS] ? PASS : BET);
+    }
+}
+
+inline void dealCards(Xoshiro256& rng, int* cards) {
+    cards[0] = static_cast<int>(rng.nextBelow(NUM_CARDS));
+    cards[1] = static_cast<int>(rng.nextBelow(NUM_CARDS - 1));
+    if (cards[1] >= cards[0]) {
+        ++cards[1];
+    }
+}
+
+// Média e soma dos quadrados dos desvios (Welford), combináveis entre threads.
+struct RunningStats {
+    long long count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    void add(double x) {
+        ++count;
+        double delta = x - mean;
+        mean += delta / count;
+        m2 += delta * (x - mean);
+    }
+
+    void merge(const RunningStats& other) {
+        if (other.count == 0) {
+            return;
+        }
+        long long total = count + other.count;
+        double delta = other.mean - mean;
+        mean += delta * other.count / total;
+        m2 += other.m2 + delta * delta * (static_cast<double>(count) * other.count / total);
+        count = total;
+    }
+};
+
+double evaluate(const Policy* const* seats, History history, const int* cards) {
+    const HistoryInfo& info = HISTORY_INFO[history];
+    if (info.row < 0) {
+        return terminalPayoff(info, cards);
+    }
+    const double* s = seats[info.player]->at(cards[info.player], info.row);
+    double value = 0.0;
+    for (int a = 0; a < NUM_ACTIONS; ++a) {
+        if (s[a] > 0) {
+            value += s[a] * evaluate(seats, nextHistory(history, a), cards);
+        }
+    }
+    return value;
+}
+
+} // namespace
+
+Policy Policy::fromTrainer(CFRTrainer& trainer) {
+    Policy policy;
+    policy.name = "CFR";
+    trainer.getAverageStrategy(policy.strategy);
+    return policy;
+}
+
+Policy Policy::fromStrategyFile(const StrategyFile& file) {
+    Policy policy;
+    policy.name = "checkpoint";
+    std::memcpy(policy.strategy, file.averageStrategy(), sizeof(policy.strategy));
+    return policy;
+}
+
+bool Policy::fromMLP(const MLPModel& model, Policy& policy) {
+    if (model.inputSize() != NUM_FEATURES || model.outputSize() != NUM_ACTIONS) {
+        std::cerr << "A rede espera " << model.inputSize() << " entradas e " << model.outputSize()
+                  << " saidas; o Kuhn Poker usa " << NUM_FEATURES << " e " << NUM_ACTIONS << "." << std::endl;
+        return false;
+    }
+    double features[NUM_FEATURES];
+    float inputs[NUM_INFOSETS * NUM_FEATURES];
+    float outputs[NUM_INFOSETS * NUM_ACTIONS];
+    for (int infoSet = 0; infoSet < NUM_INFOSETS; ++infoSet) {
+        InfoSetTable::features(infoSet % NUM_CARDS, infoSet / NUM_CARDS, features);
+        for (int f = 0; f < NUM_FEATURES; ++f) {
+            inputs[infoSet * NUM_FEATURES + f] = static_cast<float>(features[f]);
+        }
+    }
+    model.forwardBatch(inputs, NUM_INFOSETS, outputs);
+    for (int i = 0; i < NUM_INFOSETS * NUM_ACTIONS; ++i) {
+        policy.strategy[i] = outputs[i];
+    }
+    policy.name = "mlp";
+    return true;
+}
+
+bool Policy::fromCSV(const std::string& path, Policy& policy) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "Nao foi possivel abrir " << path << std::endl;
+        return false;
+    }
+
+    policy.name = path;
+    bool seen[NUM_INFOSETS] = {};
+    std::string line;
+    std::getline(in, line); // cabeçalho
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        std::istringstream fields(line);
+        std::string card, history, pass, bet;
+        if (!std::getline(fields, card, ',') || !std::getline(fields, history, ',')
+            || !std::getline(fields, pass, ',') || !std::getline(fields, bet, ',')) {
+            continue;
+        }
+        int infoSet = InfoSetTable::parse(card + "/" + history);
+        if (infoSet < 0) {
+            continue;
+        }
+        policy.strategy[infoSet * NUM_ACTIONS + PASS] = std::atof(pass.c_str());
+        policy.strategy[infoSet * NUM_ACTIONS + BET] = std::atof(bet.c_str());
+        seen[infoSet] = true;
+    }
+
+    for (int infoSet = 0; infoSet < NUM_INFOSETS; ++infoSet) {
+        if (!seen[infoSet]) {
+            std::cerr << "CSV " << path << " sem o infoset " << InfoSetTable::name(infoSet) << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+Policy Policy::textbook() {
+    // { probabilidade de PASS } por (histórico, carta), como no script Python.
+    static const double PASS_PROB[NUM_HISTORIES][NUM_CARDS] = {
+        { 2.0 / 3.0, 1.0, 0.0 }, // ""  : J blefa 1/3, Q passa, K aposta
+        { 1.0, 2.0 / 3.0, 0.0 }, // "p" : J passa, Q aposta 1/3, K aposta
+        { 1.0, 2.0 / 3.0, 0.0 }, // "b" : J desiste, Q paga 1/3, K paga
+        { 1.0, 1.0, 0.0 },       // "pb": paga apenas com Rei
+    };
+
+    Policy policy;
+    policy.name = "GTO teorico";
+    for (int h = 0; h < NUM_HISTORIES; ++h) {
+        for (int c = 0; c < NUM_CARDS; ++c) {
+            int infoSet = InfoSetTable::index(c, h);
+            policy.strategy[infoSet * NUM_ACTIONS + PASS] = PASS_PROB[h][c];
+            policy.strategy[infoSet * NUM_ACTIONS + BET] = 1.0 - PASS_PROB[h][c];
+        }
+    }
+    return policy;
+}
+
+bool Policy::load(const std::string& spec, Policy& policy) {
+    if (spec == "gto") {
+        policy = textbook();
+        return true;
+    }
+    if (spec.size() > 4 && spec.compare(spec.size() - 4, 4, ".csv") == 0) {
+        return fromCSV(spec, policy);
+    }
+    if (spec.size() > 5 && spec.compare(spec.size() - 5, 5, ".kmlp") == 0) {
+        MLPModel model;
+        if (!model.load(spec) || !fromMLP(model, policy)) {
+            return false;
+        }
+        policy.name = spec;
+        return true;
+    }
+    StrategyFile file;
+    if (!file.open(spec)) {
+        return false;
+    }
+    if (file.numInfoSets() != NUM_INFOSETS || file.numActions() != NUM_ACTIONS) {
+        std::cerr << "Checkpoint " << spec << " nao e do Kuhn Poker de " << NUM_CARDS << " cartas." << std::endl;
+        return false;
+    }
+    policy = fromStrategyFile(file);
+    policy.name = spec;
+    return true;
+}
+
+MatchResult simulateMatch(const Policy& a, const Policy& b, const MatchOptions& options) {
+    const int numThreads = options.numThreads > 0 ? options.numThreads : 1;
+    // No modo duplicado cada amostra são duas mãos.
+    const long long samples = options.duplicate ? options.hands / 2 : options.hands;
+
+    std::vector<RunningStats> stats(numThreads);
+    std::vector<std::thread> workers;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int t = 0; t < numThreads; ++t) {
+        long long count = samples / numThreads + (t < samples % numThreads ? 1 : 0);
+        workers.emplace_back([&, t, count] {
+            // Mesmo ponto de partida para todas as threads, separadas por jump().
+            Xoshiro256 rng(options.seed);
+            for (int j = 0; j < t; ++j) {
+                rng.jump();
+            }
+            const Policy* aFirst[NUM_PLAYERS] = { &a, &b };
+            const Policy* aSecond[NUM_PLAYERS] = { &b, &a };
+            int cards[NUM_PLAYERS];
+            RunningStats local;
+
+            for (long long i = 0; i < count; ++i) {
+                dealCards(rng, cards);
+                if (options.duplicate) {
+                    double first = playHand(aFirst, cards, rng);
+                    double second = -playHand(aSecond, cards, rng);
+                    local.add(0.5 * (first + second));
+                }
+                else if (i & 1) {
+                    local.add(-playHand(aSecond, cards, rng));
+                }
+                else {
+                    local.add(playHand(aFirst, cards, rng));
+                }
+            }
+            stats[t] = local;
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    RunningStats total;
+    for (const RunningStats& s : stats) {
+        total.merge(s);
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    MatchResult result;
+    result.hands = options.duplicate ? total.count * 2 : total.count;
+    result.mean = total.mean;
+    result.standardError = total.count > 1 ? std::sqrt(total.m2 / (total.count - 1) / total.count) : 0.0;
+    result.ciLow = result.mean - 1.96 * result.standardError;
+    result.ciHigh = result.mean + 1.96 * result.standardError;
+    result.seconds = elapsed.count();
+    result.handsPerSecond = result.hands / result.seconds;
+    return result;
+}
+
+double expectedValue(const Policy& a, const Policy& b) {
+    const Policy* aFirst[NUM_PLAYERS] = { &a, &b };
+    const Policy* aSecond[NUM_PLAYERS] = { &b, &a };
+    const double chance = 1.0 / (NUM_CARDS * (NUM_CARDS - 1));
+
+    double value = 0.0;
+    int cards[NUM_PLAYERS];
+    for (cards[0] = 0; cards[0] < NUM_CARDS; ++cards[0]) {
+        for (cards[1] = 0; cards[1] < NUM_CARDS; ++cards[1]) {
+            if (cards[0] == cards[1]) {
+                continue;
+            }
+            value += 0.5 * chance * (evaluate(aFirst, ROOT_HISTORY, cards) - evaluate(aSecond, ROOT_HISTORY, cards));
+        }
+    }
+    return value;
+}
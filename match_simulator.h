@@ -0,0 +1,60 @@
+#pragma once
+// Arquivo: match_simulator.h
+// Simulador nativo de confrontos (substitui o loop do simulate_match.py).
+
+#include "cfr_poker.h"
+#include <cstdint>
+#include <string>
+
+class MLPModel;
+class StrategyFile;
+
+// Uma política é só uma tabela de estratégia no mesmo layout da InfoSetTable.
+// Pode vir do treinador, de um checkpoint mapeado, de um CSV (ex: a tabela
+// pré-calculada da rede neural) ou do bot "teórico" do simulate_match.py.
+struct Policy {
+    std::string name;
+    double strategy[NUM_INFOSETS * NUM_ACTIONS];
+
+    const double* at(int card, int history) const {
+        return &strategy[InfoSetTable::index(card, history) * NUM_ACTIONS];
+    }
+
+    static Policy fromTrainer(CFRTrainer& trainer);
+    static Policy fromStrategyFile(const StrategyFile& file);
+    // Avalia a rede em todos os infosets de uma vez (um único forwardBatch).
+    static bool fromMLP(const MLPModel& model, Policy& policy);
+    // CSV no formato card,history,pass_prob,bet_prob. Retorna false se falhar.
+    static bool fromCSV(const std::string& path, Policy& policy);
+    // Mesma estratégia de get_textbook_gto_action no simulate_match.py.
+    static Policy textbook();
+    // "gto", um checkpoint .kcfr, um .csv ou uma rede .kmlp.
+    static bool load(const std::string& spec, Policy& policy);
+};
+
+struct MatchOptions {
+    long long hands = 1000000;
+    int numThreads = 1;
+    uint64_t seed = 0;
+    // Mãos duplicadas: cada distribuição é jogada duas vezes, com os assentos
+    // trocados, e o par conta como uma amostra. Remove a sorte das cartas.
+    bool duplicate = false;
+};
+
+// Resultados do ponto de vista da política A, em fichas por mão.
+struct MatchResult {
+    long long hands;
+    double mean;
+    double standardError;
+    double ciLow;  // Intervalo de confiança de 95%
+    double ciHigh;
+    double seconds;
+    double handsPerSecond;
+};
+
+// Joga "hands" mãos entre A e B em várias threads (assentos alternados).
+MatchResult simulateMatch(const Policy& a, const Policy& b, const MatchOptions& options);
+
+// Valor esperado exato de A contra B (média dos dois assentos), enumerando
+// todas as distribuições e ações. Variância zero: é o "modo EV".
+double expectedValue(const Policy& a, const Policy& b);
@@ -0,0 +1,169 @@
+// Arquivo: mlp.cpp
+
+#include "mlp.h"
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+bool MLPModel::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Erro ao abrir o modelo: " << path << std::endl;
+        return false;
+    }
+    in.seekg(0, std::ios::end);
+    uint64_t remaining = static_cast<uint64_t>(in.tellg());
+    in.seekg(0, std::ios::beg);
+
+    char magic[8];
+    uint32_t header[2];
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!in || std::memcmp(magic, MLP_MAGIC, sizeof(MLP_MAGIC)) != 0 || header[0] != MLP_VERSION) {
+        std::cerr << "Modelo invalido ou de outra versao: " << path << std::endl;
+        return false;
+    }
+    // Nada é alocado a partir do arquivo antes de validar contra o tamanho real dele.
+    if (header[1] == 0 || header[1] > static_cast<uint32_t>(MLP_MAX_LAYERS)) {
+        std::cerr << "Numero de camadas invalido (" << header[1] << ", maximo " << MLP_MAX_LAYERS << "): " << path
+                  << std::endl;
+        return false;
+    }
+    remaining -= sizeof(magic) + sizeof(header);
+
+    std::vector<Layer> loaded(header[1]);
+    int previousOutputs = -1;
+    std::vector<float> kernel;
+    for (Layer& layer : loaded) {
+        uint32_t shape[4];
+        in.read(reinterpret_cast<char*>(shape), sizeof(shape));
+        if (!in || shape[0] == 0 || shape[1] == 0 || shape[2] > SOFTMAX ||
+            (previousOutputs >= 0 && static_cast<int>(shape[0]) != previousOutputs)) {
+            std::cerr << "Camada invalida no modelo: " << path << std::endl;
+            return false;
+        }
+        if (shape[0] > static_cast<uint32_t>(MLP_MAX_WIDTH) || shape[1] > static_cast<uint32_t>(MLP_MAX_WIDTH)) {
+            std::cerr << "Camada larga demais (maximo " << MLP_MAX_WIDTH << "): " << path << std::endl;
+            return false;
+        }
+        layer.inputs = static_cast<int>(shape[0]);
+        layer.outputs = static_cast<int>(shape[1]);
+        layer.padded = (layer.outputs + MLP_LANES - 1) / MLP_LANES * MLP_LANES;
+        layer.activation = static_cast<int>(shape[2]);
+        if (layer.padded > MLP_MAX_WIDTH) {
+            std::cerr << "Camada larga demais (maximo " << MLP_MAX_WIDTH << "): " << path << std::endl;
+            return false;
+        }
+        const uint64_t layerBytes =
+            sizeof(shape) + (static_cast<uint64_t>(layer.inputs) + 1) * layer.outputs * sizeof(float);
+        if (layerBytes > remaining) {
+            std::cerr << "Modelo truncado: " << path << std::endl;
+            return false;
+        }
+        remaining -= layerBytes;
+        previousOutputs = layer.outputs;
+
+        kernel.resize(static_cast<size_t>(layer.inputs) * layer.outputs);
+        layer.weights.assign(static_cast<size_t>(layer.inputs) * layer.padded, 0.0f);
+        layer.bias.assign(layer.padded, 0.0f);
+        in.read(reinterpret_cast<char*>(kernel.data()), kernel.size() * sizeof(float));
+        in.read(reinterpret_cast<char*>(layer.bias.data()), layer.outputs * sizeof(float));
+        if (!in) {
+            std::cerr << "Modelo truncado: " << path << std::endl;
+            return false;
+        }
+        for (int i = 0; i < layer.inputs; ++i) {
+            std::memcpy(&layer.weights[static_cast<size_t>(i) * layer.padded], &kernel[static_cast<size_t>(i) * layer.outputs],
+                        layer.outputs * sizeof(float));
+        }
+    }
+    layers.swap(loaded);
+    return true;
+}
+
+// Passa Rows linhas pela rede inteira com os buffers na pilha. Para cada
+// bloco de MLP_LANES saídas, os acumuladores (Rows x MLP_LANES floats) ficam em
+// registradores durante todo o produto com a camada; o bias entra no início e
+// o ReLU é aplicado na hora de gravar o bloco. Nada volta para a memória
+// principal entre as camadas.
+template <int Rows>
+void MLPModel::forwardTile(const float* inputs, float* outputs) const {
+    alignas(32) float buffers[2][Rows][MLP_MAX_WIDTH];
+    const int inputWidth = inputSize();
+    for (int r = 0; r < Rows; ++r) {
+        std::memcpy(buffers[0][r], inputs + r * inputWidth, inputWidth * sizeof(float));
+    }
+
+    int current = 0;
+    for (const Layer& layer : layers) {
+        const float (*x)[MLP_MAX_WIDTH] = buffers[current];
+        float (*y)[MLP_MAX_WIDTH] = buffers[current ^ 1];
+        const int padded = layer.padded;
+        const float* weights = layer.weights.data();
+        const bool relu = layer.activation == RELU;
+
+        for (int o = 0; o < padded; o += MLP_LANES) {
+            float acc[Rows][MLP_LANES];
+            for (int r = 0; r < Rows; ++r) {
+                for (int l = 0; l < MLP_LANES; ++l) {
+                    acc[r][l] = layer.bias[o + l];
+                }
+            }
+            for (int i = 0; i < layer.inputs; ++i) {
+                const float* w = weights + static_cast<size_t>(i) * padded + o;
+                for (int r = 0; r < Rows; ++r) {
+                    const float xi = x[r][i];
+                    for (int l = 0; l < MLP_LANES; ++l) {
+                        acc[r][l] += xi * w[l];
+                    }
+                }
+            }
+            for (int r = 0; r < Rows; ++r) {
+                for (int l = 0; l < MLP_LANES; ++l) {
+                    y[r][o + l] = relu && acc[r][l] < 0.0f ? 0.0f : acc[r][l];
+                }
+            }
+        }
+
+        if (layer.activation == SOFTMAX) {
+            for (int r = 0; r < Rows; ++r) {
+                float maxValue = y[r][0];
+                for (int o = 1; o < layer.outputs; ++o) {
+                    maxValue = y[r][o] > maxValue ? y[r][o] : maxValue;
+                }
+                float sum = 0.0f;
+                for (int o = 0; o < layer.outputs; ++o) {
+                    y[r][o] = std::exp(y[r][o] - maxValue);
+                    sum += y[r][o];
+                }
+                const float scale = 1.0f / sum;
+                for (int o = 0; o < layer.outputs; ++o) {
+                    y[r][o] *= scale;
+                }
+            }
+        }
+        current ^= 1;
+    }
+
+    const int outputWidth = outputSize();
+    for (int r = 0; r < Rows; ++r) {
+        std::memcpy(outputs + r * outputWidth, buffers[current][r], outputWidth * sizeof(float));
+    }
+}
+
+void MLPModel::forward(const float* input, float* output) const {
+    forwardTile<1>(input, output);
+}
+
+void MLPModel::forwardBatch(const float* inputs, int count, float* outputs) const {
+    const int inputWidth = inputSize();
+    const int outputWidth = outputSize();
+    int row = 0;
+    for (; row + MLP_TILE <= count; row += MLP_TILE) {
+        forwardTile<MLP_TILE>(inputs + row * inputWidth, outputs + row * outputWidth);
+    }
+    for (; row < count; ++row) {
+        forwardTile<1>(inputs + row * inputWidth, outputs + row * outputWidth);
+    }
+}
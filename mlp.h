@@ -0,0 +1,62 @@
+#pragma once
+// Arquivo: mlp.h
+// Inferência nativa da rede destilada pelo train_nn.py (Dense + ReLU/softmax),
+// em float32 e só na CPU. Substitui o model.predict do TensorFlow, caro demais
+// para chamar a cada decisão.
+//
+// Formato .kmlp (little-endian), escrito por export_mlp() no mlp_export.py:
+//
+//   char     magic[8]      "KUHNMLP"
+//   uint32   version       MLP_VERSION
+//   uint32   numLayers
+//   por camada:
+//     uint32 inputs, outputs, activation (0 = linear, 1 = relu, 2 = softmax), reserved
+//     float  kernel[inputs][outputs]   (mesma ordem do layer.get_weights() do Keras)
+//     float  bias[outputs]
+//
+// Na carga, cada linha do kernel é completada com zeros até um múltiplo de
+// MLP_LANES floats. O produto camada a camada vira "y += x[i] * W[i]": o loop
+// interno percorre as saídas em passos de registrador, sem dependência entre
+// iterações, e o compilador o vetoriza sem precisar reordenar somas.
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+const uint32_t MLP_VERSION = 1;
+const char MLP_MAGIC[8] = { 'K', 'U', 'H', 'N', 'M', 'L', 'P', '\0' };
+const int MLP_LANES = 8;        // floats em um registrador AVX
+const int MLP_MAX_WIDTH = 1024; // Largura máxima de camada, já com padding
+const int MLP_MAX_LAYERS = 64;  // Teto do numLayers lido do arquivo
+const int MLP_TILE = 4;         // Linhas processadas juntas no modo em lote
+
+class MLPModel {
+public:
+    enum Activation { LINEAR = 0, RELU = 1, SOFTMAX = 2 };
+
+    bool load(const std::string& path);
+
+    int inputSize() const { return layers.empty() ? 0 : layers.front().inputs; }
+    int outputSize() const { return layers.empty() ? 0 : layers.back().outputs; }
+
+    // Uma decisão: input tem inputSize() floats, output recebe outputSize().
+    void forward(const float* input, float* output) const;
+    // Lote: count linhas contíguas de entrada e de saída. Cada bloco de
+    // MLP_TILE linhas reaproveita a mesma linha de pesos enquanto está no cache.
+    void forwardBatch(const float* inputs, int count, float* outputs) const;
+
+private:
+    struct Layer {
+        int inputs;
+        int outputs;
+        int padded; // outputs arredondado para múltiplo de MLP_LANES
+        int activation;
+        std::vector<float> weights; // [inputs][padded]
+        std::vector<float> bias;    // [padded]
+    };
+
+    std::vector<Layer> layers;
+
+    template <int Rows>
+    void forwardTile(const float* inputs, float* outputs) const;
+};
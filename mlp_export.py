@@ -0,0 +1,22 @@
+# Arquivo: mlp_export.py
+# Exporta uma rede Keras (camadas Dense) para o formato .kmlp lido pelo
+# MLPModel do C++ (formato descrito em mlp.h).
+
+import struct
+
+MLP_MAGIC = b"KUHNMLP\0"
+MLP_VERSION = 1
+ACTIVATIONS = {"linear": 0, "relu": 1, "softmax": 2}
+
+
+def export_mlp(model, path):
+    dense_layers = [layer for layer in model.layers if layer.get_weights()]
+    with open(path, "wb") as f:
+        f.write(MLP_MAGIC)
+        f.write(struct.pack("<II", MLP_VERSION, len(dense_layers)))
+        for layer in dense_layers:
+            kernel, bias = layer.get_weights()
+            activation = ACTIVATIONS[layer.get_config()["activation"]]
+            f.write(struct.pack("<IIII", kernel.shape[0], kernel.shape[1], activation, 0))
+            f.write(kernel.astype("<f4").tobytes())
+            f.write(bias.astype("<f4").tobytes())
@@ -0,0 +1,410 @@
+// Arquivo: parallel_trainer.cpp
+// Treinamento amostrado multithread (CFRTrainer::trainParallel).
+//
+// Modo atômico (padrão): todas as threads leem e somam direto em uma cópia
+// atômica da tabela, aplicando o accumulateRegret da regra a cada soma, como
+// o train(). Não é determinístico. As rodadas continuam existindo, mas só
+// para medir a convergência entre elas.
+//
+// Modo shards: durante uma rodada a tabela global fica congelada e só é lida;
+// cada thread escreve os incrementos de arrependimento e estratégia no seu
+// próprio InfoSetTable. No fim da rodada a thread principal soma os shards na
+// ordem das threads e aplica a regra de atualização: com a estratégia
+// congelada, a rodada inteira é uma iteração para o accumulateRegret (com o t
+// da primeira distribuição da rodada). Por isso o tamanho da rodada é o total
+// de todas as threads: o número de threads não muda a convergência.
+//
+// Nos dois modos a distribuição de índice global g (contando as anteriores)
+// usa t = g + 1 nos pesos da média e, com atualizações alternadas, atualiza o
+// jogador g % 2, como no train(). O desconto do DCFR é aplicado entre as
+// rodadas, uma vez para cada distribuição da rodada.
+//
+// Com enableDataset(), cada thread grava pelo seu DatasetSampler um registro a
+// cada "every" atualizações; o push() não bloqueia, então o disco nunca segura
+// a travessia.
+
+#include "cfr_poker.h"
+#include "update_rules.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+const int TABLE_SIZE = NUM_INFOSETS * NUM_ACTIONS;
+
+// Barreira reutilizável (std::barrier só existe a partir do C++20).
+class Barrier {
+public:
+    explicit Barrier(int parties) : parties(parties), waiting(0), generation(0) {}
+
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        unsigned long long gen = generation;
+        if (++waiting == parties) {
+            waiting = 0;
+            ++generation;
+            cv.notify_all();
+            return;
+        }
+        cv.wait(lock, [&] { return gen != generation; });
+    }
+
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    int parties;
+    int waiting;
+    unsigned long long generation;
+};
+
+// Lê a estratégia da tabela global congelada e acumula no shard da thread.
+// O shard guarda os incrementos crus; a regra entra na redução.
+struct ShardAccumulator {
+    InfoSetTable& global;
+    InfoSetTable& shard;
+
+    void getStrategy(int infoSet, double* strategy) {
+        global.node(infoSet).getStrategy(strategy);
+    }
+    void getAverageStrategy(int infoSet, double* strategy) {
+        global.node(infoSet).getAverageStrategy(strategy);
+    }
+    template <class Rule>
+    void addRegret(const Rule&, int index, double value, double) {
+        shard.regretSum[index] += value;
+    }
+    void addStrategy(int index, double value) { shard.strategySum[index] += value; }
+};
+
+struct AtomicTable {
+    std::atomic<double> regretSum[TABLE_SIZE];
+    std::atomic<double> strategySum[TABLE_SIZE];
+};
+
+// Lê e escreve em uma tabela de std::atomic<double>. A regra (o corte do
+// CFR+, por exemplo) entra no mesmo compare-exchange da soma, para nunca
+// publicar um valor que ela não produziria.
+struct AtomicAccumulator {
+    AtomicTable& table;
+
+    void getStrategy(int infoSet, double* strategy) {
+        double regrets[NUM_ACTIONS];
+        for (int a = 0; a < NUM_ACTIONS; ++a) {
+            regrets[a] = table.regretSum[infoSet * NUM_ACTIONS + a].load(std::memory_order_relaxed);
+        }
+        Node(NUM_ACTIONS, 0, regrets, nullptr).getStrategy(strategy);
+    }
+    void getAverageStrategy(int infoSet, double* strategy) {
+        double sums[NUM_ACTIONS];
+        for (int a = 0; a < NUM_ACTIONS; ++a) {
+            sums[a] = table.strategySum[infoSet * NUM_ACTIONS + a].load(std::memory_order_relaxed);
+        }
+        Node(NUM_ACTIONS, 0, nullptr, sums).getAverageStrategy(strategy);
+    }
+    template <class Rule>
+    void addRegret(const Rule& rule, int index, double value, double t) {
+        std::atomic<double>& target = table.regretSum[index];
+        double current = target.load(std::memory_order_relaxed);
+        while (!target.compare_exchange_weak(current, rule.accumulateRegret(current, value, t),
+                                             std::memory_order_relaxed)) {
+        }
+    }
+    void addStrategy(int index, double value) {
+        std::atomic<double>& target = table.strategySum[index];
+        double current = target.load(std::memory_order_relaxed);
+        while (!target.compare_exchange_weak(current, current + value, std::memory_order_relaxed)) {
+        }
+    }
+};
+
+// Amostragem do dataset de uma thread: um registro a cada "every" atualizações.
+struct DatasetSampler {
+    DatasetWriter* writer;
+    int every;
+    int countdown;
+
+    template <class Accumulator>
+    void record(Accumulator& acc, int card, int row, const double* advantages) {
+        if (--countdown > 0) {
+            return;
+        }
+        countdown = every;
+        double features[NUM_FEATURES];
+        double strategy[NUM_ACTIONS];
+        InfoSetTable::features(card, row, features);
+        acc.getAverageStrategy(InfoSetTable::index(card, row), strategy);
+        writer->push(features, strategy, advantages);
+    }
+};
+
+// Mesma recursão de CFRTrainer::cfr, mas lendo e escrevendo pelo acumulador.
+// "histories" é a tabela de históricos com os payoffs das regras do treinador.
+template <class Rule, class Accumulator>
+double shardCfr(const Rule& rule, Accumulator& acc, DatasetSampler& sampler, const HistoryInfo* histories,
+                const int* cards, History history, double p0, double p1, int updatePlayer, double t) {
+    const HistoryInfo& info = histories[history];
+    int player_to_act = info.player;
+
+    if (info.row < 0) {
+        int payoff_for_p0 = info.foldPayoff;
+        if (info.showdown != 0) {
+            payoff_for_p0 = (cards[0] > cards[1]) ? info.showdown : -info.showdown;
+        }
+        return (player_to_act == 0) ? payoff_for_p0 : -payoff_for_p0;
+    }
+
+    int infoSet = InfoSetTable::index(cards[player_to_act], info.row);
+    double strategy[NUM_ACTIONS];
+    double actionUtils[NUM_ACTIONS];
+    acc.getStrategy(infoSet, strategy);
+    double nodeUtility = 0;
+
+    for (int i = 0; i < NUM_ACTIONS; ++i) {
+        History next = nextHistory(history, i);
+        if (player_to_act == 0) {
+            actionUtils[i] =
+                -shardCfr(rule, acc, sampler, histories, cards, next, p0 * strategy[i], p1, updatePlayer, t);
+        }
+        else {
+            actionUtils[i] =
+                -shardCfr(rule, acc, sampler, histories, cards, next, p0, p1 * strategy[i], updatePlayer, t);
+        }
+        nodeUtility += strategy[i] * actionUtils[i];
+    }
+
+    if (updatePlayer >= 0 && updatePlayer != player_to_act) {
+        return nodeUtility;
+    }
+
+    double reachProb = (player_to_act == 0) ? p1 : p0;
+    double myReachProb = (player_to_act == 0) ? p0 : p1;
+    const double weight = rule.averagingWeight(t);
+    double advantages[NUM_ACTIONS];
+    for (int i = 0; i < NUM_ACTIONS; ++i) {
+        advantages[i] = reachProb * (actionUtils[i] - nodeUtility);
+        acc.addRegret(rule, infoSet * NUM_ACTIONS + i, advantages[i], t);
+        acc.addStrategy(infoSet * NUM_ACTIONS + i, weight * myReachProb * strategy[i]);
+    }
+    if (sampler.writer) {
+        sampler.record(acc, cards[player_to_act], info.row, advantages);
+    }
+
+    return nodeUtility;
+}
+
+// Roda "count" distribuições sorteadas com o gerador da thread; a primeira
+// tem o índice global "first".
+template <class Rule, class Accumulator>
+double runIterations(const Rule& rule, Accumulator& acc, DatasetSampler& sampler, const HistoryInfo* histories,
+                     std::mt19937& rng, int* deck, long long first, int count, bool alternating) {
+    int cards[NUM_PLAYERS];
+    double utility = 0.0;
+    for (int i = 0; i < count; ++i) {
+        std::shuffle(deck, deck + NUM_CARDS, rng);
+        cards[0] = deck[0];
+        cards[1] = deck[1];
+        const long long g = first + i;
+        const int updatePlayer = alternating ? static_cast<int>(g % NUM_PLAYERS) : -1;
+        utility += shardCfr(rule, acc, sampler, histories, cards, ROOT_HISTORY, 1.0, 1.0, updatePlayer,
+                            static_cast<double>(g + 1));
+    }
+    return utility;
+}
+
+// Cada thread tem um fluxo próprio, derivado da semente, do índice e das
+// iterações já feitas: uma segunda chamada (ou um --resume) não repete as
+// distribuições da anterior.
+std::mt19937 threadRng(unsigned int seed, int thread, long long iterations) {
+    const uint64_t done = static_cast<uint64_t>(iterations);
+    std::seed_seq seq{ seed, static_cast<unsigned int>(thread), static_cast<unsigned int>(done),
+                       static_cast<unsigned int>(done >> 32) };
+    return std::mt19937(seq);
+}
+
+} // namespace
+
+int CFRTrainer::trainParallel(int iterations, const ParallelOptions& parallel, const ConvergenceOptions& options) {
+    switch (updateRule.kind) {
+    case UpdateRule::VANILLA: return trainParallelWith(VanillaCFR(), iterations, parallel, options);
+    case UpdateRule::LINEAR: return trainParallelWith(LinearCFR(), iterations, parallel, options);
+    case UpdateRule::DISCOUNTED:
+        return trainParallelWith(DiscountedCFR{ updateRule.alpha, updateRule.beta, updateRule.gamma }, iterations,
+                                 parallel, options);
+    default: return trainParallelWith(CFRPlus(), iterations, parallel, options);
+    }
+}
+
+template <class Rule>
+int CFRTrainer::trainParallelWith(const Rule& rule, int iterations, const ParallelOptions& parallel,
+                                  const ConvergenceOptions& options) {
+    const int numThreads = parallel.numThreads > 0 ? parallel.numThreads : 1;
+    const int syncInterval = parallel.syncInterval > 0 ? parallel.syncInterval : 1;
+
+    if (verbose) {
+        std::cout << "Iniciando treinamento paralelo (Kuhn Poker, " << updateRule.name() << ") por " << iterations
+                  << " iteracoes em "
+                  << numThreads << " threads (" << (parallel.atomicUpdates ? "atomico" : "shards") << ")..."
+                  << std::endl;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<double> utilities(numThreads, 0.0);
+    DatasetWriter* writer = dataset && dataset->isOpen() ? dataset.get() : nullptr;
+    int done = 0;
+
+    // Modo atômico: as threads somam direto em "shared", que é copiada para a
+    // tabela ao fim de cada rodada. Modo shards: um InfoSetTable por thread.
+    std::unique_ptr<AtomicTable> shared;
+    std::vector<std::unique_ptr<InfoSetTable>> shards;
+    if (parallel.atomicUpdates) {
+        shared.reset(new AtomicTable);
+        for (int i = 0; i < TABLE_SIZE; ++i) {
+            shared->regretSum[i].store(table.regretSum[i], std::memory_order_relaxed);
+            shared->strategySum[i].store(table.strategySum[i], std::memory_order_relaxed);
+        }
+    }
+    else {
+        for (int t = 0; t < numThreads; ++t) {
+            shards.emplace_back(new InfoSetTable);
+        }
+    }
+
+    // Duas barreiras por rodada: início (contagens prontas) e fim (rodada terminada).
+    // A rodada tem syncInterval distribuições ao todo, divididas entre as
+    // threads; a thread t começa no índice global roundStart + roundOffsets[t].
+    std::vector<int> roundCounts(numThreads, 0);
+    std::vector<int> roundOffsets(numThreads, 0);
+    long long roundStart = 0;
+    Barrier barrier(numThreads + 1);
+    bool stop = false;
+
+    // totalIterations avança a cada rodada; as threads semeiam pelo valor inicial.
+    const long long firstIteration = totalIterations;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < numThreads; ++t) {
+        workers.emplace_back([&, t] {
+            DatasetSampler sampler{ writer, datasetEvery, datasetEvery };
+            std::mt19937 rng = threadRng(parallel.seed, t, firstIteration);
+            int deck[NUM_CARDS] = { 0, 1, 2 };
+            auto rounds = [&](auto& acc) {
+                for (;;) {
+                    barrier.wait();
+                    if (stop) {
+                        return;
+                    }
+                    utilities[t] += runIterations(rule, acc, sampler, histories, rng, deck,
+                                                  roundStart + roundOffsets[t],
+                                                  roundCounts[t], updateRule.alternating);
+                    barrier.wait();
+                }
+            };
+            if (shared) {
+                AtomicAccumulator acc{ *shared };
+                rounds(acc);
+            }
+            else {
+                ShardAccumulator acc{ table, *shards[t] };
+                rounds(acc);
+            }
+        });
+    }
+
+    int nextCheck = options.checkInterval;
+    int nextCheckpoint = checkpointInterval;
+    while (done < iterations) {
+        // Divisão fixa: as primeiras threads recebem o resto.
+        const int roundSize = iterations - done < syncInterval ? iterations - done : syncInterval;
+        for (int t = 0, offset = 0; t < numThreads; ++t) {
+            roundCounts[t] = roundSize / numThreads + (t < roundSize % numThreads ? 1 : 0);
+            roundOffsets[t] = offset;
+            offset += roundCounts[t];
+        }
+        roundStart = totalIterations;
+
+        barrier.wait();
+        barrier.wait();
+
+        if (shared) {
+            // As threads estão paradas na barreira: a cópia é um retrato consistente.
+            for (int i = 0; i < TABLE_SIZE; ++i) {
+                table.regretSum[i] = shared->regretSum[i].load(std::memory_order_relaxed);
+                table.strategySum[i] = shared->strategySum[i].load(std::memory_order_relaxed);
+            }
+        }
+        else {
+            // Redução determinística: sempre na ordem das threads.
+            double regretDelta[TABLE_SIZE] = {};
+            for (int t = 0; t < numThreads; ++t) {
+                InfoSetTable& shard = *shards[t];
+                for (int i = 0; i < TABLE_SIZE; ++i) {
+                    regretDelta[i] += shard.regretSum[i];
+                    table.strategySum[i] += shard.strategySum[i];
+                }
+                *shards[t] = InfoSetTable();
+            }
+            const double t = static_cast<double>(roundStart + 1);
+            for (int i = 0; i < TABLE_SIZE; ++i) {
+                table.regretSum[i] = rule.accumulateRegret(table.regretSum[i], regretDelta[i], t);
+            }
+        }
+
+        done += roundSize;
+        totalIterations += roundSize;
+
+        if constexpr (Rule::DISCOUNTS) {
+            for (long long g = roundStart; g < totalIterations; ++g) {
+                rule.discount(table.regretSum, table.strategySum, TABLE_SIZE, static_cast<double>(g + 1));
+            }
+            if (shared) {
+                for (int i = 0; i < TABLE_SIZE; ++i) {
+                    shared->regretSum[i].store(table.regretSum[i], std::memory_order_relaxed);
+                    shared->strategySum[i].store(table.strategySum[i], std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // Como no train(), mas na barreira: as rodadas não caem nos múltiplos exatos.
+        if (checkpointInterval > 0 && done >= nextCheckpoint) {
+            while (nextCheckpoint <= done) {
+                nextCheckpoint += checkpointInterval;
+            }
+            saveCheckpoint(checkpointPath);
+        }
+
+        if (options.checkInterval > 0 && done >= nextCheck) {
+            while (nextCheck <= done) {
+                nextCheck += options.checkInterval;
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (checkConvergence(done, elapsed.count(), options)) {
+                break;
+            }
+        }
+    }
+
+    stop = true;
+    barrier.wait();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    double utility = 0.0;
+    for (double u : utilities) {
+        utility += u;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (verbose) {
+        std::cout << "Treinamento concluido apos " << done << " iteracoes." << std::endl;
+        if (done > 0) {
+            std::cout << "Utilidade Media Final: " << utility / done << std::endl;
+            std::cout << "Iteracoes por segundo: " << done / elapsed.count() << std::endl;
+        }
+    }
+    return done;
+}
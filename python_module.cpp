@@ -0,0 +1,420 @@
+// Arquivo: python_module.cpp
+// Módulo Python "kuhn_cfr": o CFRTrainer direto do Python, sem passar pelo CSV.
+//
+// Escrito na API C do CPython, sem pybind11 nem NumPy na compilação. As
+// tabelas saem como memoryview 2D de float64 apontando para os arrays do
+// C++, então np.asarray(solver.regret_sum) é uma visão sem cópia, com forma
+// (NUM_INFOSETS, NUM_ACTIONS) e linhas na ordem de InfoSetTable::index.
+//
+//   import kuhn_cfr, numpy as np
+//   solver = kuhn_cfr.Solver(seed=1)
+//   solver.train(1000000)                    # GIL liberado durante o treino
+//   x, y = map(np.asarray, solver.dataset()) # features one-hot e estratégia média
+//
+// Compilação: python setup.py build_ext --inplace
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include "cfr_poker.h"
+#include <random>
+
+// --- TableView: exporta um buffer double[rows][cols] de outro objeto ---
+
+struct TableViewObject {
+    PyObject_HEAD
+    PyObject* owner;  // Mantém vivo o dono da memória
+    double* data;
+    Py_ssize_t shape[2];
+    Py_ssize_t strides[2];
+};
+
+static void TableView_dealloc(TableViewObject* self) {
+    Py_XDECREF(self->owner);
+    Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
+}
+
+static int TableView_getbuffer(PyObject* obj, Py_buffer* view, int flags) {
+    TableViewObject* self = reinterpret_cast<TableViewObject*>(obj);
+    if (flags & PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "as tabelas do solver sao somente leitura");
+        return -1;
+    }
+    view->obj = obj;
+    Py_INCREF(obj);
+    view->buf = self->data;
+    view->len = self->shape[0] * self->shape[1] * static_cast<Py_ssize_t>(sizeof(double));
+    view->readonly = 1;
+    view->itemsize = sizeof(double);
+    view->format = (flags & PyBUF_FORMAT) ? const_cast<char*>("d") : nullptr;
+    view->ndim = (flags & PyBUF_ND) ? 2 : 1;
+    view->shape = (flags & PyBUF_ND) ? self->shape : nullptr;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? self->strides : nullptr;
+    view->suboffsets = nullptr;
+    view->internal = nullptr;
+    return 0;
+}
+
+static PyBufferProcs TableView_buffer = { TableView_getbuffer, nullptr };
+
+static PyTypeObject TableViewType = { PyVarObject_HEAD_INIT(nullptr, 0) };
+
+// memoryview (rows x cols) sobre "data", que pertence a "owner".
+static PyObject* tableView(PyObject* owner, double* data, Py_ssize_t rows, Py_ssize_t cols) {
+    TableViewObject* view = PyObject_New(TableViewObject, &TableViewType);
+    if (!view) {
+        return nullptr;
+    }
+    Py_INCREF(owner);
+    view->owner = owner;
+    view->data = data;
+    view->shape[0] = rows;
+    view->shape[1] = cols;
+    view->strides[0] = cols * static_cast<Py_ssize_t>(sizeof(double));
+    view->strides[1] = sizeof(double);
+    PyObject* memory = PyMemoryView_FromObject(reinterpret_cast<PyObject*>(view));
+    Py_DECREF(view);
+    return memory;
+}
+
+// Matriz (rows x cols) nova, guardada num bytearray para o memoryview ser o único dono.
+static PyObject* newMatrix(Py_ssize_t rows, Py_ssize_t cols, double** data) {
+    PyObject* bytes = PyByteArray_FromStringAndSize(nullptr, rows * cols * static_cast<Py_ssize_t>(sizeof(double)));
+    if (!bytes) {
+        return nullptr;
+    }
+    *data = reinterpret_cast<double*>(PyByteArray_AS_STRING(bytes));
+    PyObject* result = tableView(bytes, *data, rows, cols);
+    Py_DECREF(bytes);
+    return result;
+}
+
+// --- Solver ---
+
+struct SolverObject {
+    PyObject_HEAD
+    CFRTrainer* trainer;
+    bool busy;  // Treinando com o GIL liberado: outras chamadas que mexem no treinador falham
+    double average[NUM_INFOSETS * NUM_ACTIONS];
+};
+
+static void Solver_dealloc(SolverObject* self) {
+    delete self->trainer;
+    Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
+}
+
+static int Solver_init(SolverObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = { "seed", "rule", "alternating", nullptr };
+    PyObject* seedArg = Py_None;
+    const char* ruleName = "cfr+";
+    int alternating = 1;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|Osp", const_cast<char**>(keywords), &seedArg, &ruleName,
+                                     &alternating)) {
+        return -1;
+    }
+    // O treinador não é trocado depois de criado: outra thread pode estar
+    // treinando nele, e visões de regret_sum/strategy_sum apontam para ele.
+    if (self->trainer) {
+        PyErr_SetString(PyExc_RuntimeError, "o solver ja foi inicializado");
+        return -1;
+    }
+    UpdateRule rule;
+    if (!UpdateRule::parse(ruleName, rule)) {
+        PyErr_Format(PyExc_ValueError, "regra desconhecida: %s", ruleName);
+        return -1;
+    }
+    rule.alternating = alternating != 0;
+    unsigned int seed = 0;
+    if (seedArg == Py_None) {
+        seed = std::random_device()();
+    }
+    else {
+        seed = static_cast<unsigned int>(PyLong_AsUnsignedLongMask(seedArg));
+        if (PyErr_Occurred()) {
+            return -1;
+        }
+    }
+    self->trainer = new CFRTrainer(seed);
+    self->trainer->setUpdateRule(rule);
+    self->trainer->setVerbose(false);
+    self->busy = false;
+    return 0;
+}
+
+// Solver.__new__ sem __init__ deixa o objeto sem treinador.
+static bool checkInitialized(SolverObject* self) {
+    if (!self->trainer) {
+        PyErr_SetString(PyExc_RuntimeError, "o solver nao foi inicializado");
+        return false;
+    }
+    return true;
+}
+
+static bool checkIdle(SolverObject* self) {
+    if (!checkInitialized(self)) {
+        return false;
+    }
+    if (self->busy) {
+        PyErr_SetString(PyExc_RuntimeError, "o solver esta treinando em outra thread");
+        return false;
+    }
+    return true;
+}
+
+static PyObject* runTraining(SolverObject* self, int iterations, int vectorized, bool releaseGil) {
+    if (!checkIdle(self)) {
+        return nullptr;
+    }
+    if (iterations < 0) {
+        PyErr_SetString(PyExc_ValueError, "iterations deve ser >= 0");
+        return nullptr;
+    }
+    CFRTrainer* trainer = self->trainer;
+    int done = 0;
+    self->busy = true;
+    if (releaseGil) {
+        Py_BEGIN_ALLOW_THREADS
+        done = vectorized ? trainer->trainVectorized(iterations) : trainer->train(iterations);
+        Py_END_ALLOW_THREADS
+    }
+    else {
+        done = vectorized ? trainer->trainVectorized(iterations) : trainer->train(iterations);
+    }
+    self->busy = false;
+    return PyLong_FromLong(done);
+}
+
+static PyObject* Solver_train(SolverObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = { "iterations", "vectorized", nullptr };
+    int iterations = 0;
+    int vectorized = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "i|p", const_cast<char**>(keywords), &iterations, &vectorized)) {
+        return nullptr;
+    }
+    return runTraining(self, iterations, vectorized, true);
+}
+
+// Passos curtos: mantém o GIL, que para poucas iterações custa menos do que soltá-lo.
+static PyObject* Solver_step(SolverObject* self, PyObject* args, PyObject* kwargs) {
+    static const char* keywords[] = { "iterations", "vectorized", nullptr };
+    int iterations = 1;
+    int vectorized = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|ip", const_cast<char**>(keywords), &iterations, &vectorized)) {
+        return nullptr;
+    }
+    return runTraining(self, iterations, vectorized, false);
+}
+
+static PyObject* Solver_exploitability(SolverObject* self, PyObject*) {
+    if (!checkIdle(self)) {
+        return nullptr;
+    }
+    return PyFloat_FromDouble(self->trainer->exploitability());
+}
+
+static PyObject* Solver_save(SolverObject* self, PyObject* args) {
+    const char* path = nullptr;
+    if (!PyArg_ParseTuple(args, "s", &path) || !checkIdle(self)) {
+        return nullptr;
+    }
+    if (!self->trainer->saveCheckpoint(path)) {
+        PyErr_Format(PyExc_OSError, "falha ao salvar %s", path);
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+static PyObject* Solver_load(SolverObject* self, PyObject* args) {
+    const char* path = nullptr;
+    if (!PyArg_ParseTuple(args, "s", &path) || !checkIdle(self)) {
+        return nullptr;
+    }
+    if (!self->trainer->loadCheckpoint(path)) {
+        PyErr_Format(PyExc_OSError, "falha ao carregar %s", path);
+        return nullptr;
+    }
+    Py_RETURN_NONE;
+}
+
+// (features, labels): a entrada one-hot de cada infoset e a estratégia média
+// correspondente, prontos para o model.fit() do train_nn.py.
+static PyObject* Solver_dataset(SolverObject* self, PyObject*) {
+    if (!checkIdle(self)) {
+        return nullptr;
+    }
+    double* features = nullptr;
+    double* labels = nullptr;
+    PyObject* x = newMatrix(NUM_INFOSETS, NUM_FEATURES, &features);
+    PyObject* y = x ? newMatrix(NUM_INFOSETS, NUM_ACTIONS, &labels) : nullptr;
+    if (!y) {
+        Py_XDECREF(x);
+        return nullptr;
+    }
+    for (int infoSet = 0; infoSet < NUM_INFOSETS; ++infoSet) {
+        InfoSetTable::features(infoSet % NUM_CARDS, infoSet / NUM_CARDS, &features[infoSet * NUM_FEATURES]);
+    }
+    self->trainer->getAverageStrategy(labels);
+    return Py_BuildValue("(NN)", x, y);
+}
+
+static PyObject* Solver_getRegretSum(SolverObject* self, void*) {
+    if (!checkInitialized(self)) {
+        return nullptr;
+    }
+    double* data = const_cast<double*>(self->trainer->getTable().regretSum);
+    return tableView(reinterpret_cast<PyObject*>(self), data, NUM_INFOSETS, NUM_ACTIONS);
+}
+
+static PyObject* Solver_getStrategySum(SolverObject* self, void*) {
+    if (!checkInitialized(self)) {
+        return nullptr;
+    }
+    double* data = const_cast<double*>(self->trainer->getTable().strategySum);
+    return tableView(reinterpret_cast<PyObject*>(self), data, NUM_INFOSETS, NUM_ACTIONS);
+}
+
+// A estratégia média não existe pronta no treinador: cada acesso recalcula o
+// buffer do objeto, e todas as visões já entregues passam a ver os valores novos.
+static PyObject* Solver_getAverageStrategy(SolverObject* self, void*) {
+    if (!checkIdle(self)) {
+        return nullptr;
+    }
+    self->trainer->getAverageStrategy(self->average);
+    return tableView(reinterpret_cast<PyObject*>(self), self->average, NUM_INFOSETS, NUM_ACTIONS);
+}
+
+static PyObject* Solver_getIterations(SolverObject* self, void*) {
+    if (!checkInitialized(self)) {
+        return nullptr;
+    }
+    return PyLong_FromLongLong(self->trainer->getIterations());
+}
+
+static PyObject* Solver_getInfoSets(SolverObject*, void*) {
+    PyObject* names = PyList_New(NUM_INFOSETS);
+    if (!names) {
+        return nullptr;
+    }
+    for (int infoSet = 0; infoSet < NUM_INFOSETS; ++infoSet) {
+        PyList_SET_ITEM(names, infoSet, PyUnicode_FromString(InfoSetTable::name(infoSet).c_str()));
+    }
+    return names;
+}
+
+static PyMethodDef Solver_methods[] = {
+    { "train", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(Solver_train)), METH_VARARGS | METH_KEYWORDS,
+      "train(iterations, vectorized=False) -> iteracoes executadas (libera o GIL)" },
+    { "step", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)()>(Solver_step)), METH_VARARGS | METH_KEYWORDS,
+      "step(iterations=1, vectorized=False) -> iteracoes executadas (mantem o GIL)" },
+    { "exploitability", reinterpret_cast<PyCFunction>(Solver_exploitability), METH_NOARGS,
+      "Exploitability da estrategia media em mbb/mao" },
+    { "dataset", reinterpret_cast<PyCFunction>(Solver_dataset), METH_NOARGS,
+      "(features, labels) de todos os infosets, calculados no C++" },
+    { "save_checkpoint", reinterpret_cast<PyCFunction>(Solver_save), METH_VARARGS, "Salva um checkpoint .kcfr" },
+    { "load_checkpoint", reinterpret_cast<PyCFunction>(Solver_load), METH_VARARGS, "Carrega um checkpoint .kcfr" },
+    { nullptr, nullptr, 0, nullptr }
+};
+
+static PyGetSetDef Solver_getset[] = {
+    { "regret_sum", reinterpret_cast<getter>(Solver_getRegretSum), nullptr,
+      "Visao sem copia de regretSum (NUM_INFOSETS x NUM_ACTIONS)", nullptr },
+    { "strategy_sum", reinterpret_cast<getter>(Solver_getStrategySum), nullptr,
+      "Visao sem copia de strategySum (NUM_INFOSETS x NUM_ACTIONS)", nullptr },
+    { "average_strategy", reinterpret_cast<getter>(Solver_getAverageStrategy), nullptr,
+      "Estrategia media, recalculada a cada acesso", nullptr },
+    { "iterations", reinterpret_cast<getter>(Solver_getIterations), nullptr, "Iteracoes acumuladas", nullptr },
+    { "infosets", reinterpret_cast<getter>(Solver_getInfoSets), nullptr, "Nomes \"carta/historico\" das linhas",
+      nullptr },
+    { nullptr, nullptr, nullptr, nullptr, nullptr }
+};
+
+static PyTypeObject SolverType = { PyVarObject_HEAD_INIT(nullptr, 0) };
+
+// --- Funções do módulo ---
+
+// features(cards, histories): matriz one-hot de estados arbitrários, como o
+// df.apply(state_to_features) do train_nn.py, mas numa passada só no C++.
+static PyObject* module_features(PyObject*, PyObject* args) {
+    PyObject* cardsArg = nullptr;
+    PyObject* historiesArg = nullptr;
+    if (!PyArg_ParseTuple(args, "OO", &cardsArg, &historiesArg)) {
+        return nullptr;
+    }
+    PyObject* cards = PySequence_Fast(cardsArg, "cards deve ser uma sequencia");
+    if (!cards) {
+        return nullptr;
+    }
+    PyObject* histories = PySequence_Fast(historiesArg, "histories deve ser uma sequencia");
+    if (!histories) {
+        Py_DECREF(cards);
+        return nullptr;
+    }
+    const Py_ssize_t rows = PySequence_Fast_GET_SIZE(cards);
+    PyObject* result = nullptr;
+    double* data = nullptr;
+    if (PySequence_Fast_GET_SIZE(histories) != rows) {
+        PyErr_SetString(PyExc_ValueError, "cards e histories precisam ter o mesmo tamanho");
+    }
+    else if ((result = newMatrix(rows, NUM_FEATURES, &data)) != nullptr) {
+        for (Py_ssize_t i = 0; i < rows; ++i) {
+            long card = PyLong_AsLong(PySequence_Fast_GET_ITEM(cards, i));
+            PyObject* historyItem = PySequence_Fast_GET_ITEM(histories, i);
+            // NaN do pandas (histórico vazio lido do CSV) conta como "".
+            const char* history = PyUnicode_Check(historyItem) ? PyUnicode_AsUTF8(historyItem) : "";
+            int row = history ? InfoSetTable::historyIndex(history) : -1;
+            if (PyErr_Occurred() || card < 0 || card >= NUM_CARDS || row < 0) {
+                if (!PyErr_Occurred()) {
+                    PyErr_Format(PyExc_ValueError, "estado invalido na linha %zd", i);
+                }
+                Py_CLEAR(result);
+                break;
+            }
+            InfoSetTable::features(static_cast<int>(card), row, &data[i * NUM_FEATURES]);
+        }
+    }
+    Py_DECREF(cards);
+    Py_DECREF(histories);
+    return result;
+}
+
+static PyMethodDef module_methods[] = {
+    { "features", module_features, METH_VARARGS, "features(cards, histories) -> matriz one-hot (n x NUM_FEATURES)" },
+    { nullptr, nullptr, 0, nullptr }
+};
+
+static PyModuleDef kuhn_module = { PyModuleDef_HEAD_INIT, "kuhn_cfr", "CFR para Kuhn Poker", -1, module_methods };
+
+PyMODINIT_FUNC PyInit_kuhn_cfr() {
+    TableViewType.tp_name = "kuhn_cfr.TableView";
+    TableViewType.tp_basicsize = sizeof(TableViewObject);
+    TableViewType.tp_dealloc = reinterpret_cast<destructor>(TableView_dealloc);
+    TableViewType.tp_as_buffer = &TableView_buffer;
+    TableViewType.tp_flags = Py_TPFLAGS_DEFAULT;
+
+    SolverType.tp_name = "kuhn_cfr.Solver";
+    SolverType.tp_doc = "Solver(seed=None, rule='cfr+', alternating=True)";
+    SolverType.tp_basicsize = sizeof(SolverObject);
+    SolverType.tp_flags = Py_TPFLAGS_DEFAULT;
+    SolverType.tp_new = PyType_GenericNew;
+    SolverType.tp_init = reinterpret_cast<initproc>(Solver_init);
+    SolverType.tp_dealloc = reinterpret_cast<destructor>(Solver_dealloc);
+    SolverType.tp_methods = Solver_methods;
+    SolverType.tp_getset = Solver_getset;
+
+    if (PyType_Ready(&TableViewType) < 0 || PyType_Ready(&SolverType) < 0) {
+        return nullptr;
+    }
+    PyObject* module = PyModule_Create(&kuhn_module);
+    if (!module) {
+        return nullptr;
+    }
+    Py_INCREF(&SolverType);
+    if (PyModule_AddObject(module, "Solver", reinterpret_cast<PyObject*>(&SolverType)) < 0) {
+        Py_DECREF(&SolverType);
+        Py_DECREF(module);
+        return nullptr;
+    }
+    PyModule_AddIntConstant(module, "NUM_INFOSETS", NUM_INFOSETS);
+    PyModule_AddIntConstant(module, "NUM_ACTIONS", NUM_ACTIONS);
+    PyModule_AddIntConstant(module, "NUM_FEATURES", NUM_FEATURES);
+    return module;
+}
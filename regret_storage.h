@@ -0,0 +1,245 @@
+#pragma once
+// Arquivo: regret_storage.h
+// Formatos de armazenamento das tabelas do GameSolver (game_solver.h).
+//
+// Nos jogos maiores o limite é a memória, não a conta: cada infoset guarda
+// NUM_ACTIONS arrependimentos e NUM_ACTIONS somas de estratégia. O solver
+// lê e grava uma linha (um infoset) por vez, sempre convertendo para double
+// na travessia, então a tabela escolhe livremente como guardar os números:
+//
+//   PlainTable<double>       8 bytes por entrada (padrão, referência)
+//   PlainTable<float>        4 bytes por entrada
+//   QuantizedTable<int32_t>  4 bytes por entrada + 2 bytes de escala por infoset
+//   QuantizedTable<int16_t>  2 bytes por entrada + 2 bytes de escala por infoset
+//
+// Interface comum:
+//   getRegrets / setRegrets(infoSet, n, valores)   linha de arrependimentos
+//   getStrategySum / addStrategy(infoSet, n, valores)
+//   discount(rule, t)   desconto do DCFR direto sobre os valores guardados
+//   rescale()           chamado a cada RESCALE_PERIOD iterações
+//   bytesPerInfoSet()
+//   MAX_ACTIONS         maior número de ações por infoset que a tabela aceita
+//                       (o GameSolver confere com static_assert)
+
+#include "rng.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+template <class T>
+class PlainTable {
+public:
+    static constexpr int MAX_ACTIONS = std::numeric_limits<int>::max();
+
+    PlainTable(int numInfoSets, int numActions)
+        : numActions(numActions), regretSum(static_cast<size_t>(numInfoSets) * numActions, T(0)),
+          strategySum(regretSum.size(), T(0)) {}
+
+    void getRegrets(int infoSet, int n, double* out) const { load(regretSum, infoSet, n, out); }
+    void getStrategySum(int infoSet, int n, double* out) const { load(strategySum, infoSet, n, out); }
+
+    void setRegrets(int infoSet, int n, const double* values) {
+        T* row = &regretSum[static_cast<size_t>(infoSet) * numActions];
+        for (int a = 0; a < n; ++a) {
+            row[a] = static_cast<T>(values[a]);
+        }
+    }
+
+    void addStrategy(int infoSet, int n, const double* values) {
+        T* row = &strategySum[static_cast<size_t>(infoSet) * numActions];
+        for (int a = 0; a < n; ++a) {
+            row[a] += static_cast<T>(values[a]);
+        }
+    }
+
+    template <class Rule>
+    void discount(const Rule& rule, double t) {
+        rule.discount(regretSum.data(), strategySum.data(), static_cast<int>(regretSum.size()), t);
+    }
+
+    void rescale() {}
+
+    size_t bytesPerInfoSet() const { return 2 * numActions * sizeof(T); }
+
+private:
+    int numActions;
+    std::vector<T> regretSum;
+    std::vector<T> strategySum;
+
+    void load(const std::vector<T>& table, int infoSet, int n, double* out) const {
+        const T* row = &table[static_cast<size_t>(infoSet) * numActions];
+        for (int a = 0; a < n; ++a) {
+            out[a] = row[a];
+        }
+    }
+};
+
+// Inteiros com escala por linha: valor = q * 2^expoente. Só as razões dentro
+// de um infoset importam (regret matching e média normalizam a linha), então
+// cada linha tem o próprio expoente e usa toda a faixa do inteiro.
+//
+// - Gravação: se a linha não cabe, o expoente sobe até caber (nunca satura).
+//   O arredondamento é estocástico, então incrementos menores que um passo
+//   da escala não somem: viram ruído sem viés.
+// - rescale(): periódico. Linhas cujo maior valor ficou abaixo de 1/4 da faixa
+//   (arrependimentos que encolheram, desconto do DCFR) descem o expoente e
+//   recuperam os bits perdidos.
+template <class Int>
+class QuantizedTable {
+public:
+    // Tamanho dos buffers de linha na pilha (addStrategy, discount).
+    static constexpr int MAX_ACTIONS = 8;
+
+    QuantizedTable(int numInfoSets, int numActions)
+        : numActions(numActions), regretSum(static_cast<size_t>(numInfoSets) * numActions, 0),
+          strategySum(regretSum.size(), 0), regretExponent(numInfoSets, MIN_EXPONENT),
+          strategyExponent(numInfoSets, MIN_EXPONENT), dither(0x5EED) {}
+
+    void getRegrets(int infoSet, int n, double* out) const {
+        load(regretSum, regretExponent[infoSet], infoSet, n, out);
+    }
+    void getStrategySum(int infoSet, int n, double* out) const {
+        load(strategySum, strategyExponent[infoSet], infoSet, n, out);
+    }
+
+    void setRegrets(int infoSet, int n, const double* values) {
+        store(regretSum, regretExponent[infoSet], infoSet, n, values);
+    }
+
+    void addStrategy(int infoSet, int n, const double* values) {
+        double row[MAX_ACTIONS];
+        getStrategySum(infoSet, n, row);
+        for (int a = 0; a < n; ++a) {
+            row[a] += values[a];
+        }
+        store(strategySum, strategyExponent[infoSet], infoSet, n, row);
+    }
+
+    // A regra roda sem mudanças sobre blocos de DISCOUNT_ROWS infosets
+    // convertidos para double, e a volta usa o mesmo arredondamento
+    // estocástico. Multiplicar os inteiros direto com arredondamento comum
+    // congelaria os valores pequenos (q * 0.999 arredonda para q).
+    template <class Rule>
+    void discount(const Rule& rule, double t) {
+        if constexpr (Rule::DISCOUNTS) {
+            double regrets[DISCOUNT_ROWS * MAX_ACTIONS];
+            double sums[DISCOUNT_ROWS * MAX_ACTIONS];
+            const int numInfoSets = static_cast<int>(regretExponent.size());
+            for (int first = 0; first < numInfoSets; first += DISCOUNT_ROWS) {
+                const int rows = numInfoSets - first < DISCOUNT_ROWS ? numInfoSets - first : DISCOUNT_ROWS;
+                for (int r = 0; r < rows; ++r) {
+                    getRegrets(first + r, numActions, regrets + r * numActions);
+                    getStrategySum(first + r, numActions, sums + r * numActions);
+                }
+                rule.discount(regrets, sums, rows * numActions, t);
+                for (int r = 0; r < rows; ++r) {
+                    setRegrets(first + r, numActions, regrets + r * numActions);
+                    store(strategySum, strategyExponent[first + r], first + r, numActions, sums + r * numActions);
+                }
+            }
+        }
+    }
+
+    void rescale() {
+        const int numInfoSets = static_cast<int>(regretExponent.size());
+        for (int infoSet = 0; infoSet < numInfoSets; ++infoSet) {
+            tighten(regretSum, regretExponent[infoSet], infoSet);
+            tighten(strategySum, strategyExponent[infoSet], infoSet);
+        }
+    }
+
+    size_t bytesPerInfoSet() const { return 2 * numActions * sizeof(Int) + 2 * sizeof(int8_t); }
+
+private:
+    static constexpr int DISCOUNT_ROWS = 256;
+    static constexpr int MIN_EXPONENT = -126;
+    static constexpr int DIGITS = std::numeric_limits<Int>::digits;
+    // Folga de 1 para o arredondamento para cima.
+    static constexpr double LIMIT = static_cast<double>(std::numeric_limits<Int>::max()) - 1.0;
+
+    int numActions;
+    std::vector<Int> regretSum;
+    std::vector<Int> strategySum;
+    std::vector<int8_t> regretExponent;
+    std::vector<int8_t> strategyExponent;
+    uint64_t dither;
+
+    // 2^e montado direto nos bits do double (e normal, sem chamada à libm).
+    static double power(int e) {
+        const uint64_t bits = static_cast<uint64_t>(e + 1023) << 52;
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    void load(const std::vector<Int>& table, int exponent, int infoSet, int n, double* out) const {
+        const Int* row = &table[static_cast<size_t>(infoSet) * numActions];
+        const double scale = power(exponent);
+        for (int a = 0; a < n; ++a) {
+            out[a] = row[a] * scale;
+        }
+    }
+
+    // Menor expoente que faz a linha caber, sem descer abaixo do atual (quem
+    // desce é o rescale()). O arredondamento sorteia para baixo ou para cima
+    // com probabilidade proporcional à distância, então E[q] = valor / escala.
+    void store(std::vector<Int>& table, int8_t& exponent, int infoSet, int n, const double* values) {
+        double maxAbs = 0.0;
+        for (int a = 0; a < n; ++a) {
+            maxAbs = std::fabs(values[a]) > maxAbs ? std::fabs(values[a]) : maxAbs;
+        }
+        double inverse = power(-exponent);
+        if (maxAbs * inverse > LIMIT) {
+            int magnitude;
+            std::frexp(maxAbs, &magnitude);
+            int e = magnitude - DIGITS > exponent ? magnitude - DIGITS : exponent;
+            while (std::ldexp(maxAbs, -e) > LIMIT) {
+                ++e;
+            }
+            exponent = static_cast<int8_t>(e);
+            inverse = power(-e);
+        }
+        // 16 bits de sorteio por entrada, quatro por chamada do gerador.
+        Int* row = &table[static_cast<size_t>(infoSet) * numActions];
+        uint64_t bits = 0;
+        for (int a = 0; a < n; ++a) {
+            if ((a & 3) == 0) {
+                bits = splitMix64(dither);
+            }
+            const double x = values[a] * inverse;
+            int64_t q = static_cast<int64_t>(x);
+            q -= x < static_cast<double>(q) ? 1 : 0; // piso sem chamar std::floor
+            const double u = static_cast<double>(bits & 0xFFFF) * (1.0 / 65536.0);
+            bits >>= 16;
+            row[a] = static_cast<Int>(x - static_cast<double>(q) > u ? q + 1 : q);
+        }
+    }
+
+    // Desloca a linha para que o maior valor volte a ocupar entre 1/4 e 1/2
+    // da faixa. Linhas zeradas voltam ao expoente mínimo.
+    void tighten(std::vector<Int>& table, int8_t& exponent, int infoSet) {
+        Int* row = &table[static_cast<size_t>(infoSet) * numActions];
+        Int maxAbs = 0;
+        for (int a = 0; a < numActions; ++a) {
+            const Int v = row[a] < 0 ? static_cast<Int>(-row[a]) : row[a];
+            maxAbs = v > maxAbs ? v : maxAbs;
+        }
+        if (maxAbs == 0) {
+            exponent = MIN_EXPONENT;
+            return;
+        }
+        int magnitude;
+        std::frexp(static_cast<double>(maxAbs), &magnitude);
+        int shift = DIGITS - 1 - magnitude;
+        shift = exponent - shift < MIN_EXPONENT ? exponent - MIN_EXPONENT : shift;
+        if (shift <= 0) {
+            return;
+        }
+        for (int a = 0; a < numActions; ++a) {
+            row[a] = static_cast<Int>(row[a] * (static_cast<int64_t>(1) << shift));
+        }
+        exponent = static_cast<int8_t>(exponent - shift);
+    }
+};
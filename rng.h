@@ -0,0 +1,134 @@
+#pragma once
+// Arquivo: rng.h
+
+#include <cstdint>
+
+// Geradores rápidos para os loops quentes (simulação de partidas etc.).
+// O std::mt19937 tem 2.5 KB de estado e é lento demais para 1e9 mãos.
+
+// SplitMix64: usado para espalhar uma semente em vários estados independentes.
+inline uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// xoshiro256** (Blackman & Vigna): 32 bytes de estado, período 2^256 - 1.
+// jump() avança 2^128 passos, então cada thread pode ter um fluxo próprio
+// sem sobreposição a partir da mesma semente.
+class Xoshiro256 {
+public:
+    explicit Xoshiro256(uint64_t seed = 0) {
+        uint64_t sm = seed;
+        for (int i = 0; i < 4; ++i) {
+            s[i] = splitMix64(sm);
+        }
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(s[1] * 5, 7) * 9;
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Uniforme em [0, 1) com 53 bits de mantissa.
+    double nextDouble() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    // Inteiro uniforme em [0, n) (método multiplicativo de Lemire sobre os 32
+    // bits altos, sem o descarte: o viés de no máximo n / 2^32 é irrelevante
+    // para baralhos pequenos).
+    uint32_t nextBelow(uint32_t n) { return static_cast<uint32_t>(((next() >> 32) * n) >> 32); }
+
+    void jump() {
+        static const uint64_t JUMP[] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL,
+                                         0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+        uint64_t t[4] = { 0, 0, 0, 0 };
+        for (uint64_t jump : JUMP) {
+            for (int b = 0; b < 64; ++b) {
+                if (jump & (1ULL << b)) {
+                    for (int i = 0; i < 4; ++i) {
+                        t[i] ^= s[i];
+                    }
+                }
+                next();
+            }
+        }
+        for (int i = 0; i < 4; ++i) {
+            s[i] = t[i];
+        }
+    }
+
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+
+// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"):
+// gerador baseado em contador. Cada bloco de 128 bits é uma função pura de
+// (chave, contador), então fluxos diferentes saem só de mudar "stream" no
+// contador: nada de jump() nem estado compartilhado, e o mesmo (seed, stream)
+// sempre reproduz a mesma sequência, em qualquer thread.
+class Philox4x32 {
+public:
+    explicit Philox4x32(uint64_t seed = 0, uint64_t stream = 0) : block(0), used(4) {
+        key[0] = static_cast<uint32_t>(seed);
+        key[1] = static_cast<uint32_t>(seed >> 32);
+        counter[2] = static_cast<uint32_t>(stream);
+        counter[3] = static_cast<uint32_t>(stream >> 32);
+    }
+
+    uint64_t next() {
+        if (used > 2) {
+            refill();
+        }
+        const uint64_t result = (static_cast<uint64_t>(output[used]) << 32) | output[used + 1];
+        used += 2;
+        return result;
+    }
+
+    // Mesmas conversões do Xoshiro256.
+    double nextDouble() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+    uint32_t nextBelow(uint32_t n) { return static_cast<uint32_t>(((next() >> 32) * n) >> 32); }
+
+    // Pula direto para o bloco "index" do fluxo (acesso aleatório em O(1)).
+    void seek(uint64_t index) {
+        block = index;
+        used = 4;
+    }
+
+private:
+    uint32_t key[2];
+    uint32_t counter[4] = { 0, 0, 0, 0 };
+    uint32_t output[4];
+    uint64_t block;
+    int used;
+
+    void refill() {
+        uint32_t c[4] = { static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32), counter[2], counter[3] };
+        uint32_t k[2] = { key[0], key[1] };
+        for (int round = 0; round < 10; ++round) {
+            const uint64_t p0 = static_cast<uint64_t>(0xD2511F53u) * c[0];
+            const uint64_t p1 = static_cast<uint64_t>(0xCD9E8D57u) * c[2];
+            const uint32_t next[4] = { static_cast<uint32_t>(p1 >> 32) ^ c[1] ^ k[0], static_cast<uint32_t>(p1),
+                                       static_cast<uint32_t>(p0 >> 32) ^ c[3] ^ k[1], static_cast<uint32_t>(p0) };
+            for (int i = 0; i < 4; ++i) {
+                c[i] = next[i];
+            }
+            k[0] += 0x9E3779B9u;
+            k[1] += 0xBB67AE85u;
+        }
+        for (int i = 0; i < 4; ++i) {
+            output[i] = c[i];
+        }
+        ++block;
+        used = 0;
+    }
+};
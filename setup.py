@@ -0,0 +1,28 @@
+# Compila o módulo Python kuhn_cfr (python_module.cpp) junto com o solver.
+#   python setup.py build_ext --inplace
+import sys
+
+from setuptools import Extension, setup
+
+if sys.platform == "win32":
+    compile_args = ["/O2", "/std:c++17", "/EHsc"]
+else:
+    compile_args = ["-O2", "-std=c++17"]
+
+kuhn_cfr = Extension(
+    "kuhn_cfr",
+    sources=[
+        "python_module.cpp",
+        "cfr_poker.cpp",
+        "cfr_vectorized.cpp",
+        "parallel_trainer.cpp",
+        "strategy_file.cpp",
+        "telemetry.cpp",
+        "dataset.cpp",
+        "alloc_counter.cpp",
+    ],
+    extra_compile_args=compile_args,
+    language="c++",
+)
+
+setup(name="kuhn_cfr", version="1.0", ext_modules=[kuhn_cfr])
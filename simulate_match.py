@@ -5,8 +5,12 @@ import numpy as np
 import tensorflow as tf
 import pandas as pd
 import random
+import subprocess
+import sys
 import time
 
+from mlp_export import export_mlp
+
 print("--- SIMULADOR DE CONFRONTO OTIMIZADO: Rede Neural vs. GTO Teorico ---")
 
 MODEL_FILENAME = "kuhn_poker_nn.keras"
@@ -50,6 +54,21 @@ for card in [0, 1, 2]:
         strategy = model_nn.predict(input_vector, verbose=0)[0]
         nn_strategy_map[state_key] = strategy
 
+# --- SIMULADOR NATIVO (C++) ---
+# Os pesos da rede vão para um .kmlp (mlp_export.py) e o confronto roda no
+# executável C++, que avalia a rede com o MLPModel (todas as threads, IC de
+# 95% e EV exato). Defina KUHN_SOLVER com o caminho do executável para usá-lo;
+# sem ele, a simulação em Python abaixo usa a tabela pré-calculada.
+native_solver = os.environ.get("KUHN_SOLVER")
+if native_solver:
+    NN_WEIGHTS_FILENAME = "kuhn_poker_nn.kmlp"
+    export_mlp(model_nn, NN_WEIGHTS_FILENAME)
+    print(f"\nUsando o simulador nativo: {native_solver}")
+    result = subprocess.run([native_solver, "--match", NN_WEIGHTS_FILENAME, "gto",
+                             "--hands", str(NUM_SIMULATIONS), "--threads", str(os.cpu_count() or 1),
+                             "--duplicate"])
+    sys.exit(result.returncode)
+
 # --- DEFINIÇÃO DOS JOGADORES (COM NN OTIMIZADA) ---
 
 def get_nn_action_optimized(card, history):
@@ -0,0 +1,143 @@
+// Arquivo: strategy_file.cpp
+
+#include "strategy_file.h"
+#include "cfr_poker.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+StrategyFile::StrategyFile() : data(nullptr), size(0) {
+#ifdef _WIN32
+    fileHandle = INVALID_HANDLE_VALUE;
+    mappingHandle = nullptr;
+#else
+    fd = -1;
+#endif
+}
+
+StrategyFile::~StrategyFile() {
+    close();
+}
+
+bool StrategyFile::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        std::cerr << "Nao foi possivel abrir " << path << std::endl;
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(fileHandle, &fileSize);
+    size = static_cast<size_t>(fileSize.QuadPart);
+    mappingHandle = size > 0 ? CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    if (mappingHandle != nullptr) {
+        data = static_cast<const unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Nao foi possivel abrir " << path << std::endl;
+        return false;
+    }
+    struct stat st;
+    fstat(fd, &st);
+    size = static_cast<size_t>(st.st_size);
+    if (size > 0) {
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        data = mapped == MAP_FAILED ? nullptr : static_cast<const unsigned char*>(mapped);
+    }
+#endif
+
+    if (data == nullptr) {
+        std::cerr << "Nao foi possivel mapear " << path << std::endl;
+        close();
+        return false;
+    }
+
+    // Valida o cabeçalho e os limites de cada seção antes de expor os ponteiros.
+    bool valid = size >= sizeof(CheckpointHeader);
+    if (valid) {
+        const CheckpointHeader& h = header();
+        uint64_t tableBytes = static_cast<uint64_t>(h.numInfoSets) * h.numActions * sizeof(double);
+        valid = std::memcmp(h.magic, CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) == 0
+            && h.version == CHECKPOINT_VERSION
+            && h.averageOffset % CHECKPOINT_ALIGNMENT == 0
+            && h.averageOffset + tableBytes <= size
+            && h.regretOffset + tableBytes <= size
+            && h.strategySumOffset + tableBytes <= size
+            && h.rngOffset + h.rngStateSize <= size;
+    }
+    if (!valid) {
+        std::cerr << "Arquivo de estrategia invalido ou de versao incompativel: " << path << std::endl;
+        close();
+        return false;
+    }
+    return true;
+}
+
+void StrategyFile::close() {
+#ifdef _WIN32
+    if (data != nullptr) {
+        UnmapViewOfFile(data);
+    }
+    if (mappingHandle != nullptr) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle);
+    }
+    fileHandle = INVALID_HANDLE_VALUE;
+    mappingHandle = nullptr;
+#else
+    if (data != nullptr) {
+        munmap(const_cast<unsigned char*>(data), size);
+    }
+    if (fd >= 0) {
+        ::close(fd);
+    }
+    fd = -1;
+#endif
+    data = nullptr;
+    size = 0;
+}
+
+bool exportStrategyCSV(const double* averageStrategy, const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Nao foi possivel criar " << path << std::endl;
+        return false;
+    }
+
+    out << "card,history,pass_prob,bet_prob\n";
+    out.precision(17);
+    for (int infoSet = 0; infoSet < NUM_INFOSETS; ++infoSet) {
+        std::string name = InfoSetTable::name(infoSet);
+        size_t slash = name.find('/');
+        const double* s = averageStrategy + infoSet * NUM_ACTIONS;
+        out << name.substr(0, slash) << "," << name.substr(slash + 1) << "," << s[PASS] << "," << s[BET] << "\n";
+    }
+    return static_cast<bool>(out);
+}
+
+bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    // O rename do Windows falha se o destino existe; MoveFileEx substitui.
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
+}
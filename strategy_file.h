@@ -0,0 +1,82 @@
+#pragma once
+// Arquivo: strategy_file.h
+
+#include <cstdint>
+#include <string>
+
+// Formato binário versionado do checkpoint (.kcfr). Todos os números no
+// formato nativo (little-endian nas nossas máquinas); cada seção começa em
+// um offset múltiplo de 64 bytes:
+//
+//   [cabeçalho de 64 bytes]
+//   [estratégia média: double[numInfoSets][numActions]]  <- seção "mmapável"
+//   [regretSum:        double[numInfoSets][numActions]]
+//   [strategySum:      double[numInfoSets][numActions]]
+//   [estado do RNG (texto do operator<< do std::mt19937)]
+//
+// A estratégia média vem primeiro e já normalizada, para que um processo que
+// só joga possa mapear o arquivo e usar os ponteiros direto, sem parsing.
+struct CheckpointHeader {
+    char magic[8];             // "KUHNCFR"
+    uint32_t version;
+    uint32_t numInfoSets;
+    uint32_t numActions;
+    uint32_t rngStateSize;     // Bytes do estado do RNG
+    uint64_t iterations;       // Iterações acumuladas pelo treinador
+    uint64_t averageOffset;
+    uint64_t regretOffset;
+    uint64_t strategySumOffset;
+    uint64_t rngOffset;
+};
+
+const uint32_t CHECKPOINT_VERSION = 1;
+const char CHECKPOINT_MAGIC[8] = { 'K', 'U', 'H', 'N', 'C', 'F', 'R', '\0' };
+const uint64_t CHECKPOINT_ALIGNMENT = 64;
+
+// Leitor somente-leitura: mapeia o arquivo na memória (mmap / MapViewOfFile)
+// e expõe a seção de estratégia média sem copiar nada.
+class StrategyFile {
+public:
+    StrategyFile();
+    ~StrategyFile();
+    StrategyFile(const StrategyFile&) = delete;
+    StrategyFile& operator=(const StrategyFile&) = delete;
+
+    // Retorna false (e imprime o motivo) se o arquivo não existir ou não for válido.
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return data != nullptr; }
+
+    const CheckpointHeader& header() const { return *reinterpret_cast<const CheckpointHeader*>(data); }
+    int numInfoSets() const { return static_cast<int>(header().numInfoSets); }
+    int numActions() const { return static_cast<int>(header().numActions); }
+    uint64_t iterations() const { return header().iterations; }
+
+    // Estratégia média de um infoset (índice de InfoSetTable::index).
+    const double* averageStrategy() const { return reinterpret_cast<const double*>(data + header().averageOffset); }
+    const double* strategy(int infoSet) const { return averageStrategy() + infoSet * numActions(); }
+
+    const double* regretSum() const { return reinterpret_cast<const double*>(data + header().regretOffset); }
+    const double* strategySum() const { return reinterpret_cast<const double*>(data + header().strategySumOffset); }
+    std::string rngState() const {
+        return std::string(reinterpret_cast<const char*>(data + header().rngOffset), header().rngStateSize);
+    }
+
+private:
+    const unsigned char* data;
+    size_t size;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fd;
+#endif
+};
+
+// Escreve o CSV lido por train_nn.py (card,history,pass_prob,bet_prob) a
+// partir de uma seção de estratégia média, seja ela do treinador ou mapeada.
+bool exportStrategyCSV(const double* averageStrategy, const std::string& path);
+
+// Renomeia "from" para "to", substituindo "to" de forma atômica: quem abrir
+// "to" vê o arquivo antigo ou o novo, nunca nenhum dos dois.
+bool replaceFile(const std::string& from, const std::string& to);
@@ -0,0 +1,81 @@
+// Arquivo: subgame_resolver.cpp
+
+#include "subgame_resolver.h"
+#include <functional>
+
+SubgameResolver::SubgameResolver(int numThreads, const KuhnRules& rules, int queueCapacity)
+    : queue(queueCapacity > 0 ? queueCapacity : 1), head(0), count(0), stopping(false) {
+    const int threads = numThreads > 0 ? numThreads : 1;
+    for (int t = 0; t < threads; ++t) {
+        workspaces.emplace_back(new CFRTrainer(0));
+        workspaces.back()->setVerbose(false);
+        workspaces.back()->setRules(rules);
+    }
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back(&SubgameResolver::run, this, std::ref(*workspaces[t]));
+    }
+}
+
+SubgameResolver::~SubgameResolver() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    notEmpty.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+bool SubgameResolver::resolve(const SubgameQuery& query, SubgameSolution& solution) {
+    return resolveBatch(&query, &solution, 1) == 1;
+}
+
+int SubgameResolver::resolveBatch(const SubgameQuery* queries, SubgameSolution* solutions, int total) {
+    if (total <= 0) {
+        return 0;
+    }
+    Batch batch;
+    batch.remaining = total;
+    batch.solved = 0;
+
+    for (int i = 0; i < total; ++i) {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return count < queue.size(); });
+        queue[(head + count) % queue.size()] = Job{ &queries[i], &solutions[i], &batch };
+        ++count;
+        lock.unlock();
+        notEmpty.notify_one();
+    }
+
+    std::unique_lock<std::mutex> lock(batch.mutex);
+    batch.done.wait(lock, [&batch] { return batch.remaining == 0; });
+    return batch.solved;
+}
+
+void SubgameResolver::run(CFRTrainer& workspace) {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            notEmpty.wait(lock, [this] { return stopping || count > 0; });
+            if (count == 0) {
+                return;
+            }
+            job = queue[head];
+            head = (head + 1) % queue.size();
+            --count;
+        }
+        notFull.notify_one();
+
+        const bool solved = workspace.solveSubgame(*job.query, *job.solution);
+
+        // Avisa ainda com o mutex do lote: assim que remaining chega a zero,
+        // quem chamou pode retornar e destruir o Batch.
+        std::lock_guard<std::mutex> lock(job.batch->mutex);
+        job.batch->solved += solved ? 1 : 0;
+        if (--job.batch->remaining == 0) {
+            job.batch->done.notify_all();
+        }
+    }
+}
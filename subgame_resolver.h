@@ -0,0 +1,64 @@
+#pragma once
+// Arquivo: subgame_resolver.h
+// Resolução de subjogos em tempo real para servir decisões: um pool fixo de
+// threads, cada uma com o seu CFRTrainer como área de trabalho, atende
+// pedidos (SubgameQuery) vindos de qualquer número de threads.
+//
+// Tudo é alocado no construtor: a fila de pedidos é um buffer circular de
+// tamanho fixo e quem espera um lote espera em uma estrutura na própria
+// pilha, então atender um pedido não faz nenhuma alocação no heap.
+//
+// O subjogo é resolvido com os alcances da raiz fixos ("unsafe resolving"):
+// cabe a quem chama passar alcances coerentes com a estratégia jogada até ali.
+
+#include "cfr_poker.h"
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class SubgameResolver {
+public:
+    // queueCapacity limita os pedidos pendentes; quem enfileira além disso espera.
+    explicit SubgameResolver(int numThreads, const KuhnRules& rules = KuhnRules(), int queueCapacity = 1024);
+    ~SubgameResolver();
+    SubgameResolver(const SubgameResolver&) = delete;
+    SubgameResolver& operator=(const SubgameResolver&) = delete;
+
+    // Seguro de várias threads ao mesmo tempo; bloqueia até a resposta.
+    bool resolve(const SubgameQuery& query, SubgameSolution& solution);
+    // Distribui "count" pedidos pelo pool e espera todos. Retorna quantos
+    // foram resolvidos (os inválidos ficam de fora; ver solveSubgame).
+    int resolveBatch(const SubgameQuery* queries, SubgameSolution* solutions, int count);
+
+    int numThreads() const { return static_cast<int>(workers.size()); }
+
+private:
+    // Lote de quem chamou, na pilha dele; os workers só contam as respostas.
+    struct Batch {
+        int remaining;
+        int solved;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+
+    struct Job {
+        const SubgameQuery* query;
+        SubgameSolution* solution;
+        Batch* batch;
+    };
+
+    std::vector<std::unique_ptr<CFRTrainer>> workspaces;
+    std::vector<std::thread> workers;
+
+    std::vector<Job> queue;
+    size_t head;   // Próximo pedido a ser atendido
+    size_t count;  // Pedidos na fila
+    bool stopping;
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+
+    void run(CFRTrainer& workspace);
+};
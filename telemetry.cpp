@@ -0,0 +1,165 @@
+// Arquivo: telemetry.cpp
+
+#include "telemetry.h"
+#include <chrono>
+#include <iostream>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define KUHN_HAS_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define KUHN_HAS_RDTSC
+#endif
+
+uint64_t telemetryTicks() {
+#ifdef KUHN_HAS_RDTSC
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+bool TelemetryStream::compiledIn() {
+#ifdef KUHN_TELEMETRY
+    return true;
+#else
+    return false;
+#endif
+}
+
+TelemetryStream::TelemetryStream()
+    : head(0), tail(0), stopping(false), droppedSamples(0), numInfoSets(0), numActions(0) {
+}
+
+TelemetryStream::~TelemetryStream() {
+    close();
+}
+
+bool TelemetryStream::open(const std::string& path, int infoSets, int actions) {
+    if (!compiledIn()) {
+        std::cerr << "Telemetria indisponivel: compile com KUHN_TELEMETRY." << std::endl;
+        return false;
+    }
+    close();
+    out.open(path, std::ios::trunc);
+    if (!out) {
+        std::cerr << "Erro ao criar o arquivo de telemetria: " << path << std::endl;
+        return false;
+    }
+    numInfoSets = infoSets;
+    numActions = actions;
+    for (Sample& sample : ring) {
+        sample.regretMagnitude.assign(numInfoSets, 0.0);
+        sample.strategyMass.assign(numInfoSets, 0.0);
+    }
+    head.store(0);
+    tail.store(0);
+    stopping.store(false);
+    droppedSamples.store(0);
+    writer = std::thread(&TelemetryStream::run, this);
+    return true;
+}
+
+void TelemetryStream::close() {
+    if (writer.joinable()) {
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+        out.close();
+    }
+}
+
+void TelemetryStream::begin(long long iteration, const TelemetryCounters& counters) {
+    const uint64_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= CAPACITY) {
+        droppedSamples.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Sample& sample = ring[h % CAPACITY];
+    sample.baseline = true;
+    sample.iteration = iteration;
+    sample.seconds = 0.0;
+    sample.counters = counters;
+    head.store(h + 1, std::memory_order_release);
+}
+
+void TelemetryStream::push(long long iteration, double seconds, const TelemetryCounters& counters,
+                           const double* regretSum, const double* strategySum) {
+    const uint64_t h = head.load(std::memory_order_relaxed);
+    if (h - tail.load(std::memory_order_acquire) >= CAPACITY) {
+        droppedSamples.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Sample& sample = ring[h % CAPACITY];
+    sample.baseline = false;
+    sample.iteration = iteration;
+    sample.seconds = seconds;
+    sample.counters = counters;
+    for (int i = 0; i < numInfoSets; ++i) {
+        double regret = 0.0;
+        double mass = 0.0;
+        for (int a = 0; a < numActions; ++a) {
+            const double r = regretSum[i * numActions + a];
+            regret += r < 0 ? -r : r;
+            mass += strategySum[i * numActions + a];
+        }
+        sample.regretMagnitude[i] = regret;
+        sample.strategyMass[i] = mass;
+    }
+    head.store(h + 1, std::memory_order_release);
+}
+
+void TelemetryStream::run() {
+    Sample last;
+    bool hasLast = false;
+    for (;;) {
+        // Lê "stopping" antes de esvaziar: depois do sinal, uma última passada pega o que restou.
+        const bool stop = stopping.load(std::memory_order_acquire);
+        uint64_t t = tail.load(std::memory_order_relaxed);
+        while (t != head.load(std::memory_order_acquire)) {
+            const Sample& sample = ring[t % CAPACITY];
+            if (!sample.baseline) {
+                write(sample, hasLast ? &last : nullptr);
+            }
+            last = sample;
+            hasLast = true;
+            tail.store(++t, std::memory_order_release);
+        }
+        if (stop) {
+            break;
+        }
+        out.flush();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    out.flush();
+}
+
+// Uma linha JSON por amostra. Taxas e frações de tempo são relativas à amostra
+// anterior ou à marca do begin() (ou ao zero, se não houver nenhuma das duas).
+void TelemetryStream::write(const Sample& sample, const Sample* previous) {
+    const TelemetryCounters& c = sample.counters;
+    const long long iterations = sample.iteration - (previous ? previous->iteration : 0);
+    const double seconds = sample.seconds - (previous ? previous->seconds : 0.0);
+    const uint64_t nodes = c.nodes - (previous ? previous->counters.nodes : 0);
+    const uint64_t timed = c.timedIterations - (previous ? previous->counters.timedIterations : 0);
+    const double nodesPerIteration = timed > 0 ? static_cast<double>(nodes) / timed : 0.0;
+    const uint64_t total = c.totalTicks - (previous ? previous->counters.totalTicks : 0);
+    const uint64_t lookup = c.lookupTicks - (previous ? previous->counters.lookupTicks : 0);
+    const uint64_t update = c.updateTicks - (previous ? previous->counters.updateTicks : 0);
+    const double scale = total > 0 ? 1.0 / total : 0.0;
+
+    out << "{\"iteration\":" << sample.iteration << ",\"seconds\":" << sample.seconds
+        << ",\"iterations_per_second\":" << (seconds > 0 ? iterations / seconds : 0.0)
+        << ",\"nodes_per_second\":" << (seconds > 0 ? nodesPerIteration * iterations / seconds : 0.0)
+        << ",\"time_share\":{\"lookup\":" << lookup * scale << ",\"update\":" << update * scale
+        << ",\"recursion\":" << (total > 0 ? (total - lookup - update) * scale : 0.0) << "}"
+        << ",\"regret_magnitude\":[";
+    for (int i = 0; i < numInfoSets; ++i) {
+        out << (i ? "," : "") << sample.regretMagnitude[i];
+    }
+    out << "],\"strategy_sum\":[";
+    for (int i = 0; i < numInfoSets; ++i) {
+        out << (i ? "," : "") << sample.strategyMass[i];
+    }
+    out << "],\"dropped\":" << dropped() << "}\n";
+}
@@ -0,0 +1,98 @@
+#pragma once
+// Arquivo: telemetry.h
+
+// Telemetria do treinamento: vazão (iterações e nós por segundo), divisão do
+// tempo entre busca na tabela, atualização dos arrependimentos e o resto da
+// recursão, e a magnitude dos arrependimentos/somas de estratégia de cada
+// infoset. As amostras vão para um arquivo JSONL, uma linha por amostra.
+//
+// Compile com KUHN_TELEMETRY definido para instrumentar o loop de treinamento.
+// Sem a flag, tudo o que está dentro de KUHN_TELEMETRY_ONLY(...) desaparece do
+// código e TelemetryStream::open() falha.
+//
+// O loop quente só incrementa contadores e copia uma amostra para um buffer
+// circular; a formatação e a escrita no disco ficam numa thread separada. Se
+// o buffer estiver cheio a amostra é descartada (e contada), nunca bloqueia.
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef KUHN_TELEMETRY
+#define KUHN_TELEMETRY_ONLY(...) __VA_ARGS__
+#else
+#define KUHN_TELEMETRY_ONLY(...)
+#endif
+
+// Contador de ciclos barato (rdtsc em x86; relógio monotônico nos demais).
+uint64_t telemetryTicks();
+
+// Contadores do loop quente. Só uma iteração a cada TIMING_PERIOD é medida
+// (com uma versão instrumentada da travessia), então as demais rodam sem
+// nenhum custo extra; nós visitados e frações de tempo são extrapolados a
+// partir dessas iterações amostradas.
+struct TelemetryCounters {
+    static const int TIMING_PERIOD = 256;
+
+    uint64_t timedIterations = 0;
+    uint64_t nodes = 0;        // Nós visitados nas iterações medidas
+    uint64_t lookupTicks = 0;
+    uint64_t updateTicks = 0;
+    uint64_t totalTicks = 0;
+};
+
+class TelemetryStream {
+public:
+    static bool compiledIn();
+
+    TelemetryStream();
+    ~TelemetryStream();
+    TelemetryStream(const TelemetryStream&) = delete;
+    TelemetryStream& operator=(const TelemetryStream&) = delete;
+
+    // Abre o arquivo e inicia a thread de escrita. numInfoSets e numActions
+    // dimensionam os buffers agora, então push() nunca aloca.
+    bool open(const std::string& path, int numInfoSets, int numActions);
+    // Esvazia o buffer, encerra a thread e fecha o arquivo.
+    void close();
+    bool isOpen() const { return writer.joinable(); }
+
+    // Marca o início de uma chamada de treino: "iteration" é o total acumulado
+    // (após um --resume, as iterações restauradas) e os segundos voltam a zero.
+    // A primeira amostra seguinte mede as taxas a partir daqui, sem gerar linha.
+    void begin(long long iteration, const TelemetryCounters& counters);
+    // Chamado pelo loop de treinamento; as tabelas têm numInfoSets * numActions posições.
+    void push(long long iteration, double seconds, const TelemetryCounters& counters, const double* regretSum,
+              const double* strategySum);
+
+    long long dropped() const { return droppedSamples.load(std::memory_order_relaxed); }
+
+private:
+    static const int CAPACITY = 64;
+
+    struct Sample {
+        bool baseline;  // Marca de begin(): só serve de referência para a próxima
+        long long iteration;
+        double seconds;
+        TelemetryCounters counters;
+        std::vector<double> regretMagnitude;  // Soma de |regretSum| por infoset
+        std::vector<double> strategyMass;     // Soma de strategySum por infoset
+    };
+
+    Sample ring[CAPACITY];
+    // Fila de um produtor e um consumidor: o treinador avança head, a thread de escrita avança tail.
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> tail;
+    std::atomic<bool> stopping;
+    std::atomic<long long> droppedSamples;
+    int numInfoSets;
+    int numActions;
+    std::ofstream out;
+    std::thread writer;
+
+    void run();
+    void write(const Sample& sample, const Sample* previous);
+};
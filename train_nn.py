@@ -5,6 +5,7 @@ import tensorflow as tf
 from tensorflow.keras.models import Sequential
 from tensorflow.keras.layers import Dense
 import numpy as np
+from mlp_export import export_mlp
 
 # --- Função de Engenharia de Features Definitiva ---
 def state_to_features(card, history):
@@ -31,18 +32,32 @@ def state_to_features(card, history):
     return card_features + history_features
 
 # 1. Carregar os Dados
+# Com o módulo nativo (python setup.py build_ext --inplace), os alvos vêm
+# direto de um solver vivo, sem passar pelo CSV; sem ele, lê o CSV exportado.
 try:
-    df = pd.read_csv("kuhn_poker_gto.csv")
-    # Garante que não haja valores nulos no histórico
-    df['history'] = df['history'].fillna('')
-except FileNotFoundError:
-    print("Erro: Arquivo 'kuhn_poker_gto.csv' nao encontrado.")
-    exit()
-
-# 2. Criar o Dataset com as Novas Features Explícitas
-feature_list = df.apply(lambda row: state_to_features(row['card'], row['history']), axis=1)
-features = np.array(feature_list.tolist())
-labels = df[['pass_prob', 'bet_prob']].values
+    import kuhn_cfr
+except ImportError:
+    kuhn_cfr = None
+
+if kuhn_cfr is not None:
+    solver = kuhn_cfr.Solver(seed=0)
+    solver.train(100000, vectorized=True)
+    print(f"Solver nativo: {solver.iterations} iteracoes, exploitability {solver.exploitability():.4f} mbb/mao")
+    # 2. Features e alvos já prontos no C++ (visões sem cópia)
+    features, labels = map(np.asarray, solver.dataset())
+else:
+    try:
+        df = pd.read_csv("kuhn_poker_gto.csv")
+        # Garante que não haja valores nulos no histórico
+        df['history'] = df['history'].fillna('')
+    except FileNotFoundError:
+        print("Erro: Arquivo 'kuhn_poker_gto.csv' nao encontrado.")
+        exit()
+
+    # 2. Criar o Dataset com as Novas Features Explícitas
+    feature_list = df.apply(lambda row: state_to_features(row['card'], row['history']), axis=1)
+    features = np.array(feature_list.tolist())
+    labels = df[['pass_prob', 'bet_prob']].values
 
 # 3. Construir um Modelo Simples e Eficaz
 model = Sequential([
@@ -96,4 +111,10 @@ print(f"\nEstrategia para Rei (K):")
 print(f"  - PASS: {strategy_K[0]*100:.2f}%")
 print(f"  - BET:  {strategy_K[1]*100:.2f}%")
 
-print("\nCompare estes resultados com a saida do seu programa C++ de 10M de iteracoes.")
\ No newline at end of file
+print("\nCompare estes resultados com a saida do seu programa C++ de 10M de iteracoes.")
+
+# 8. Salvar o modelo e exportar os pesos para a inferência nativa em C++
+# (MLPModel, formato .kmlp), usada pelo simulador com --match kuhn_poker_nn.kmlp
+model.save("kuhn_poker_nn.keras")
+export_mlp(model, "kuhn_poker_nn.kmlp")
+print("Modelo salvo em kuhn_poker_nn.keras e kuhn_poker_nn.kmlp")
\ No newline at end of file
@@ -0,0 +1,74 @@
+#pragma once
+// Arquivo: update_rules.h
+// Regras de atualização do CFR como políticas em tempo de compilação.
+//
+// O treinador é um template sobre a regra: cada regra é uma struct pequena
+// com funções inline, então a escolha não custa nenhuma chamada virtual no
+// loop quente. "t" é o número da iteração, começando em 1.
+//
+//   accumulateRegret(r, delta, t): novo arrependimento acumulado
+//   averagingWeight(t):            peso da estratégia da iteração t na média
+//   discount(regret, strategy, n, t): chamado ao fim de cada iteração (DCFR)
+//
+// As regras recebem as tabelas como vetores simples, então servem tanto ao
+// CFRTrainer quanto ao GameSolver. discount() é um template sobre o tipo da
+// entrada (tabelas em float do regret_storage.h), e DISCOUNTS diz se ele faz
+// alguma coisa, para quem precisa converter a tabela antes de chamá-lo.
+
+#include <cmath>
+
+// CFR original: soma simples e média uniforme.
+struct VanillaCFR {
+    double accumulateRegret(double regret, double delta, double) const { return regret + delta; }
+    double averagingWeight(double) const { return 1.0; }
+    static constexpr bool DISCOUNTS = false;
+    template <class T>
+    void discount(T*, T*, int, double) const {}
+};
+
+// CFR+: arrependimentos cortados em zero e média ponderada pela iteração.
+struct CFRPlus {
+    double accumulateRegret(double regret, double delta, double) const {
+        double r = regret + delta;
+        return r > 0 ? r : 0;
+    }
+    double averagingWeight(double t) const { return t; }
+    static constexpr bool DISCOUNTS = false;
+    template <class T>
+    void discount(T*, T*, int, double) const {}
+};
+
+// Linear CFR: a contribuição da iteração t (arrependimento e estratégia) pesa t.
+struct LinearCFR {
+    double accumulateRegret(double regret, double delta, double t) const { return regret + t * delta; }
+    double averagingWeight(double t) const { return t; }
+    static constexpr bool DISCOUNTS = false;
+    template <class T>
+    void discount(T*, T*, int, double) const {}
+};
+
+// Discounted CFR (Brown & Sandholm): ao fim da iteração t, arrependimentos
+// positivos são multiplicados por t^a / (t^a + 1), os negativos por
+// t^b / (t^b + 1) e a soma de estratégias por (t / (t + 1))^g.
+struct DiscountedCFR {
+    double alpha;
+    double beta;
+    double gamma;
+
+    double accumulateRegret(double regret, double delta, double) const { return regret + delta; }
+    double averagingWeight(double) const { return 1.0; }
+
+    static constexpr bool DISCOUNTS = true;
+    template <class T>
+    void discount(T* regretSum, T* strategySum, int size, double t) const {
+        const double ta = std::pow(t, alpha);
+        const double tb = std::pow(t, beta);
+        const double positive = ta / (ta + 1.0);
+        const double negative = tb / (tb + 1.0);
+        const double strategy = std::pow(t / (t + 1.0), gamma);
+        for (int i = 0; i < size; ++i) {
+            regretSum[i] = static_cast<T>(regretSum[i] * (regretSum[i] > 0 ? positive : negative));
+            strategySum[i] = static_cast<T>(strategySum[i] * strategy);
+        }
+    }
+};